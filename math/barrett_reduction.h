@@ -0,0 +1,96 @@
+/**
+ *  @file math/barrett_reduction.h
+ */
+#pragma once
+#include <cassert>
+#include "common/header.h"
+
+namespace libcomp {
+namespace math {
+
+/**
+ *  @defgroup barrett_reduction Barrett reduction
+ *  @ingroup  math
+ *  @{
+ */
+
+/**
+ *  @brief  Barrett reductionによる剰余計算
+ *
+ *  実行時に与えられる法 m について、64bit整数の剰余を
+ *  除算命令を使わずに乗算とシフトのみで求める。
+ *  \f$ \lfloor (2^{64} - 1) / m \rfloor \f$ を前計算しておき、
+ *  商の近似値を128bitの乗算の上位64bitとして得る。
+ */
+class BarrettReduction {
+
+private:
+	ull m_mod;
+	ull m_inv;
+
+public:
+	/**
+	 *  @brief コンストラクタ
+	 *  @param[in] mod  法 (1 <= mod < 2^32)
+	 */
+	explicit BarrettReduction(ull mod = 1) :
+		m_mod(mod), m_inv(~0ull / mod)
+	{
+		assert(1 <= mod && mod < (1ull << 32));
+	}
+
+	/**
+	 *  @brief 法の取得
+	 *  @return 法
+	 */
+	ull modulus() const { return m_mod; }
+
+	/**
+	 *  @brief 剰余の計算
+	 *
+	 *  近似した商は真の商より高々1小さいため、補正は1回の減算で済む。
+	 *
+	 *  @param[in] z  対象とする値
+	 *  @return    \f$ z \bmod m \f$
+	 */
+	ull reduce(ull z) const {
+		const ull q = static_cast<ull>(
+			(static_cast<unsigned __int128>(z) * m_inv) >> 64);
+		const ull r = z - q * m_mod;
+		return r >= m_mod ? r - m_mod : r;
+	}
+
+	/**
+	 *  @brief 剰余上の乗算
+	 *  @param[in] a  乗算する値 (a < m)
+	 *  @param[in] b  乗算する値 (b < m)
+	 *  @return    \f$ ab \bmod m \f$
+	 */
+	ull multiply(ull a, ull b) const { return reduce(a * b); }
+
+	/**
+	 *  @brief 剰余上の累乗
+	 *
+	 *  計算量は \f$ \mathcal{O}(\log{e}) \f$。
+	 *
+	 *  @param[in] a  底 (a < m)
+	 *  @param[in] e  指数
+	 *  @return    \f$ a^e \bmod m \f$
+	 */
+	ull pow(ull a, ull e) const {
+		ull r = reduce(1);
+		for(; e > 0; e >>= 1){
+			if(e & 1){ r = multiply(r, a); }
+			a = multiply(a, a);
+		}
+		return r;
+	}
+
+};
+
+/**
+ *  @}
+ */
+
+}
+}
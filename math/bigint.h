@@ -0,0 +1,666 @@
+/**
+ *  @file math/bigint.h
+ */
+#pragma once
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+#include <cassert>
+#include "common/header.h"
+#include "math/ntt.h"
+
+namespace libcomp {
+namespace math {
+
+/**
+ *  @defgroup bigint BigInt
+ *  @ingroup  math
+ *  @{
+ */
+
+/**
+ *  @brief 多倍長整数
+ *
+ *  絶対値を \f$ 2^{32} \f$ 進の桁 (下位桁から順) で、符号を別に保持する。
+ *  乗算は短い方の桁数に応じて筆算、Karatsuba法、
+ *  3つの素数を法とする数論変換と中国剰余定理による畳み込みを切り替える。
+ *  除算は Newton 法で求めた逆数との乗算で商を推定し、少数回の補正で確定させる。
+ *  10進文字列との相互変換は \f$ 10^{9 \cdot 2^i} \f$ を境界とする分割統治で行う。
+ *  M(n) を n 桁同士の乗算の計算量として、
+ *  除算と10進変換の計算量はそれぞれ \f$ \mathcal{O}(M(n)) \f$、
+ *  \f$ \mathcal{O}(M(n) \log{n}) \f$。
+ *  数論変換による乗算は短い方の桁数が \f$ 3 \times 10^6 \f$ 以下、
+ *  積の桁数が \f$ 2^{24} \f$ 以下で正確。
+ */
+class BigInt {
+
+private:
+	typedef vector<unsigned int> Digits;
+
+	static const int NAIVE_THRESHOLD = 32;
+	static const int NTT_THRESHOLD = 1024;
+	static const int NEWTON_THRESHOLD = 512;
+	static const unsigned int BASE10 = 1000000000u;
+
+	Digits m_digits;
+	bool m_negative;
+
+	BigInt(const Digits &digits, bool negative) :
+		m_digits(digits), m_negative(negative)
+	{
+		trim(m_digits);
+		if(m_digits.empty()){ m_negative = false; }
+	}
+
+	static void trim(Digits &a){
+		while(!a.empty() && a.back() == 0){ a.pop_back(); }
+	}
+
+	static int compare(const Digits &a, const Digits &b){
+		if(a.size() != b.size()){ return a.size() < b.size() ? -1 : 1; }
+		for(size_t i = a.size(); i > 0; --i){
+			if(a[i - 1] != b[i - 1]){ return a[i - 1] < b[i - 1] ? -1 : 1; }
+		}
+		return 0;
+	}
+
+	// dst[0, dn) += src[0, sn) (sn <= dn)、桁あふれを返す
+	static unsigned int add_to(unsigned int *dst, int dn, const unsigned int *src, int sn){
+		ull carry = 0;
+		int i = 0;
+		for(; i < sn; ++i){
+			carry += static_cast<ull>(dst[i]) + src[i];
+			dst[i] = static_cast<unsigned int>(carry);
+			carry >>= 32;
+		}
+		for(; carry && i < dn; ++i){ carry = (++dst[i] == 0); }
+		return static_cast<unsigned int>(carry);
+	}
+
+	// dst[0, dn) -= src[0, sn) (sn <= dn)、借りを返す
+	static unsigned int sub_from(unsigned int *dst, int dn, const unsigned int *src, int sn){
+		unsigned int borrow = 0;
+		int i = 0;
+		for(; i < sn; ++i){
+			const ull t = static_cast<ull>(dst[i]) - src[i] - borrow;
+			dst[i] = static_cast<unsigned int>(t);
+			borrow = static_cast<unsigned int>(t >> 63);
+		}
+		for(; borrow && i < dn; ++i){ borrow = (dst[i]-- == 0); }
+		return borrow;
+	}
+
+	static Digits add(const Digits &a, const Digits &b){
+		const Digits &l = (a.size() < b.size() ? b : a);
+		const Digits &s = (a.size() < b.size() ? a : b);
+		Digits c(l.size() + 1);
+		copy(l.begin(), l.end(), c.begin());
+		add_to(c.data(), c.size(), s.data(), s.size());
+		trim(c);
+		return c;
+	}
+
+	// a - b (a >= b)
+	static Digits sub(const Digits &a, const Digits &b){
+		Digits c(a);
+		sub_from(c.data(), c.size(), b.data(), b.size());
+		trim(c);
+		return c;
+	}
+
+	// out[0, n + m) = x[0, n) * y[0, m)
+	static void naive_multiply(
+		const unsigned int *x, int n, const unsigned int *y, int m, unsigned int *out)
+	{
+		fill(out, out + n + m, 0u);
+		for(int i = 0; i < n; ++i){
+			ull carry = 0;
+			const ull xi = x[i];
+			for(int j = 0; j < m; ++j){
+				carry += xi * y[j] + out[i + j];
+				out[i + j] = static_cast<unsigned int>(carry);
+				carry >>= 32;
+			}
+			out[i + m] = static_cast<unsigned int>(carry);
+		}
+	}
+
+	// d[0, k) = |x[0, k) - y[0, h)| (h <= k)、x < y なら true を返す
+	static bool difference(
+		const unsigned int *x, int k, const unsigned int *y, int h, unsigned int *d)
+	{
+		bool less = false;
+		int i = k;
+		while(i > h && x[i - 1] == 0){ --i; }
+		if(i == h){
+			while(i > 0 && x[i - 1] == y[i - 1]){ --i; }
+			less = (i > 0 && x[i - 1] < y[i - 1]);
+		}
+		if(less){
+			copy(y, y + h, d);
+			fill(d + h, d + k, 0u);
+			sub_from(d, k, x, k);
+		}else{
+			copy(x, x + k, d);
+			sub_from(d, k, y, h);
+		}
+		return less;
+	}
+
+	// out[0, 2n) = x[0, n) * y[0, n)
+	// x0 y1 + x1 y0 = x0 y0 + x1 y1 - (x1 - x0)(y1 - y0) により中間項の桁数を抑える
+	static void karatsuba(
+		const unsigned int *x, const unsigned int *y, int n,
+		unsigned int *out, unsigned int *work)
+	{
+		if(n <= NAIVE_THRESHOLD){
+			naive_multiply(x, n, y, n, out);
+			return;
+		}
+		const int h = n / 2, k = n - h;
+		unsigned int *dx = work, *dy = work + k, *d = work + 2 * k, *t = work + 4 * k;
+		karatsuba(x, y, h, out, work + 6 * k + 1);
+		karatsuba(x + h, y + h, k, out + 2 * h, work + 6 * k + 1);
+		const bool sx = difference(x + h, k, x, h, dx);
+		const bool sy = difference(y + h, k, y, h, dy);
+		karatsuba(dx, dy, k, d, work + 6 * k + 1);
+		copy(out + 2 * h, out + 2 * n, t);
+		t[2 * k] = add_to(t, 2 * k, out, 2 * h);
+		if(sx == sy){
+			sub_from(t, 2 * k + 1, d, 2 * k);
+		}else{
+			add_to(t, 2 * k + 1, d, 2 * k);
+		}
+		add_to(out + h, 2 * n - h, t, 2 * k + 1);
+	}
+
+	static Digits karatsuba_multiply(const Digits &a, const Digits &b){
+		const Digits &s = (a.size() < b.size() ? a : b);
+		const Digits &l = (a.size() < b.size() ? b : a);
+		const int n = s.size();
+		Digits c(l.size() + n + 1), chunk(n), prod(2 * n), work(8 * n + 256);
+		for(size_t i = 0; i < l.size(); i += n){
+			const size_t len = min(l.size() - i, static_cast<size_t>(n));
+			copy(l.begin() + i, l.begin() + i + len, chunk.begin());
+			fill(chunk.begin() + len, chunk.end(), 0u);
+			karatsuba(chunk.data(), s.data(), n, prod.data(), work.data());
+			add_to(c.data() + i, c.size() - i, prod.data(), min(2 * n, static_cast<int>(c.size() - i)));
+		}
+		trim(c);
+		return c;
+	}
+
+	static Digits ntt_multiply(const Digits &a, const Digits &b){
+		const vector<GarnerDigits> d = convolve_three_primes(a, b);
+		const unsigned __int128 m1m2 = static_cast<ull>(GarnerDigits::M1) * GarnerDigits::M2;
+		Digits c(d.size() + 3);
+		unsigned __int128 carry = 0;
+		for(size_t i = 0; i < c.size(); ++i){
+			if(i < d.size()){
+				carry += d[i].t1 + static_cast<ull>(d[i].t2) * GarnerDigits::M1 + m1m2 * d[i].t3;
+			}
+			c[i] = static_cast<unsigned int>(carry);
+			carry >>= 32;
+		}
+		trim(c);
+		return c;
+	}
+
+	static Digits multiply(const Digits &a, const Digits &b){
+		if(a.empty() || b.empty()){ return Digits(); }
+		const int s = min(a.size(), b.size());
+		if(s > NTT_THRESHOLD){ return ntt_multiply(a, b); }
+		if(s > NAIVE_THRESHOLD){ return karatsuba_multiply(a, b); }
+		Digits c(a.size() + b.size());
+		naive_multiply(a.data(), a.size(), b.data(), b.size(), c.data());
+		trim(c);
+		return c;
+	}
+
+	// a を1桁の値 b で割り、商を a に書き込んで余りを返す
+	static unsigned int divide_small(Digits &a, unsigned int b){
+		ull r = 0;
+		for(size_t i = a.size(); i > 0; --i){
+			r = (r << 32) | a[i - 1];
+			a[i - 1] = static_cast<unsigned int>(r / b);
+			r %= b;
+		}
+		trim(a);
+		return static_cast<unsigned int>(r);
+	}
+
+	// Knuth の Algorithm D による筆算の除算 (b は2桁以上、a >= b)
+	static void knuth_divide(const Digits &a, const Digits &b, Digits &q, Digits &r){
+		const int n = a.size(), m = b.size();
+		const int s = __builtin_clz(b.back());
+		Digits u(n + 1), v(m);
+		for(int i = m - 1; i >= 0; --i){
+			v[i] = (b[i] << s) | (s && i > 0 ? b[i - 1] >> (32 - s) : 0u);
+		}
+		u[n] = (s ? a[n - 1] >> (32 - s) : 0u);
+		for(int i = n - 1; i >= 0; --i){
+			u[i] = (a[i] << s) | (s && i > 0 ? a[i - 1] >> (32 - s) : 0u);
+		}
+		q.assign(n - m + 1, 0u);
+		const ull base = 1ull << 32;
+		for(int j = n - m; j >= 0; --j){
+			const ull num = (static_cast<ull>(u[j + m]) << 32) | u[j + m - 1];
+			ull qhat = num / v[m - 1], rhat = num % v[m - 1];
+			while(qhat >= base || qhat * v[m - 2] > ((rhat << 32) | u[j + m - 2])){
+				--qhat;
+				rhat += v[m - 1];
+				if(rhat >= base){ break; }
+			}
+			ll borrow = 0, t = 0;
+			for(int i = 0; i < m; ++i){
+				const ull p = qhat * v[i];
+				t = static_cast<ll>(u[i + j]) - borrow - static_cast<ll>(p & 0xffffffffull);
+				u[i + j] = static_cast<unsigned int>(t);
+				borrow = static_cast<ll>(p >> 32) - (t >> 32);
+			}
+			t = static_cast<ll>(u[j + m]) - borrow;
+			u[j + m] = static_cast<unsigned int>(t);
+			q[j] = static_cast<unsigned int>(qhat);
+			if(t < 0){
+				--q[j];
+				u[j + m] += add_to(u.data() + j, m, v.data(), m);
+			}
+		}
+		r.assign(m, 0u);
+		for(int i = 0; i < m; ++i){
+			r[i] = (u[i] >> s) | (s ? u[i + 1] << (32 - s) : 0u);
+		}
+		trim(q);
+		trim(r);
+	}
+
+	static Digits shift_right(const Digits &a, int k){
+		if(static_cast<int>(a.size()) <= k){ return Digits(); }
+		return Digits(a.begin() + k, a.end());
+	}
+
+	static Digits shift_left(const Digits &a, int k){
+		if(a.empty()){ return a; }
+		Digits c(a.size() + k);
+		copy(a.begin(), a.end(), c.begin() + k);
+		return c;
+	}
+
+	// B = 2^32、m = |b| として B^{m+p} / b の近似値 (誤差は数単位)
+	static Digits reciprocal(const Digits &b, int p){
+		const int m = b.size();
+		if(m > p + 2){ return reciprocal(shift_right(b, m - p - 2), p); }
+		if(p <= NAIVE_THRESHOLD){
+			Digits one(m + p + 1), q, r;
+			one.back() = 1;
+			divide(one, b, q, r);
+			return q;
+		}
+		// x を B^{m+h} / b の近似値として
+		// X = 2 x B^{p-h} - b x^2 / B^{m+2h-p}
+		const int h = p / 2 + 1;
+		const Digits x = reciprocal(b, h);
+		const Digits y = shift_right(multiply(b, multiply(x, x)), m + 2 * h - p);
+		const Digits x2 = shift_left(add(x, x), p - h);
+		assert(compare(x2, y) >= 0);
+		return sub(x2, y);
+	}
+
+	// inv = reciprocal(b, p) を用いた除算 (|a| - |b| < p)
+	static void newton_divide(
+		const Digits &a, const Digits &b, const Digits &inv, int p, Digits &q, Digits &r)
+	{
+		const int m = b.size();
+		assert(static_cast<int>(a.size()) - m < p);
+		q = shift_right(multiply(shift_right(a, m - 1), inv), p + 1);
+		Digits qb = multiply(q, b);
+		const Digits one(1, 1u);
+		while(compare(qb, a) > 0){
+			q = sub(q, one);
+			qb = sub(qb, b);
+		}
+		r = sub(a, qb);
+		while(compare(r, b) >= 0){
+			q = add(q, one);
+			r = sub(r, b);
+		}
+	}
+
+	static void divide(const Digits &a, const Digits &b, Digits &q, Digits &r){
+		assert(!b.empty());
+		if(compare(a, b) < 0){
+			q.clear();
+			r = a;
+			return;
+		}
+		if(b.size() == 1){
+			q = a;
+			r.assign(1, divide_small(q, b[0]));
+			trim(r);
+			return;
+		}
+		const int n = a.size(), m = b.size();
+		if(m <= NEWTON_THRESHOLD || n - m <= NEWTON_THRESHOLD){
+			knuth_divide(a, b, q, r);
+			return;
+		}
+		const int p = n - m + 1;
+		newton_divide(a, b, reciprocal(b, p), p, q, r);
+	}
+
+	// 10^{9 * 2^i} とそれで割るための逆数を必要になった時点で求めて保持する
+	struct DecimalPowers {
+		vector<Digits> powers;
+		vector<Digits> inverses;
+
+		const Digits &power(int level){
+			if(powers.empty()){ powers.push_back(Digits(1, 1000000000u)); }
+			while(static_cast<int>(powers.size()) <= level){
+				powers.push_back(multiply(powers.back(), powers.back()));
+			}
+			return powers[level];
+		}
+
+		// 空の場合は筆算で割る
+		const Digits &inverse(int level){
+			const Digits &b = power(level);
+			if(static_cast<int>(inverses.size()) <= level){ inverses.resize(level + 1); }
+			if(inverses[level].empty() && static_cast<int>(b.size()) > NEWTON_THRESHOLD){
+				inverses[level] = reciprocal(b, b.size() + 1);
+			}
+			return inverses[level];
+		}
+	};
+
+	static DecimalPowers &decimal_powers(){
+		static thread_local DecimalPowers cache;
+		return cache;
+	}
+
+	// x < 10^{9 * 2^level} を 9 * 2^level 桁に0埋めして out に追記する
+	static void to_decimal(const Digits &x, int level, string &out){
+		const int width = 9 << level;
+		if(static_cast<int>(x.size()) <= NAIVE_THRESHOLD){
+			Digits y(x);
+			vector<unsigned int> chunks;
+			while(!y.empty()){ chunks.push_back(divide_small(y, BASE10)); }
+			const size_t end = out.size() + width;
+			out.append(width - 9 * chunks.size(), '0');
+			char buf[16];
+			for(size_t i = chunks.size(); i > 0; --i){
+				snprintf(buf, sizeof(buf), "%09u", chunks[i - 1]);
+				out += buf;
+			}
+			assert(out.size() == end);
+			return;
+		}
+		DecimalPowers &dp = decimal_powers();
+		const Digits &b = dp.power(level - 1);
+		const Digits &inv = dp.inverse(level - 1);
+		Digits q, r;
+		if(inv.empty()){
+			divide(x, b, q, r);
+		}else{
+			newton_divide(x, b, inv, b.size() + 1, q, r);
+		}
+		to_decimal(q, level - 1, out);
+		to_decimal(r, level - 1, out);
+	}
+
+	// chunks[l, l + 2^level) (10^9 進、下位から順) の値
+	static Digits from_decimal(const vector<unsigned int> &chunks, int l, int level){
+		const int len = 1 << level;
+		if(l >= static_cast<int>(chunks.size())){ return Digits(); }
+		if(len <= NAIVE_THRESHOLD){
+			Digits x;
+			const int r = min(l + len, static_cast<int>(chunks.size()));
+			for(int i = r - 1; i >= l; --i){
+				ull carry = chunks[i];
+				for(size_t j = 0; j < x.size(); ++j){
+					carry += static_cast<ull>(x[j]) * BASE10;
+					x[j] = static_cast<unsigned int>(carry);
+					carry >>= 32;
+				}
+				if(carry){ x.push_back(static_cast<unsigned int>(carry)); }
+			}
+			trim(x);
+			return x;
+		}
+		const Digits lo = from_decimal(chunks, l, level - 1);
+		const Digits hi = from_decimal(chunks, l + len / 2, level - 1);
+		return add(multiply(hi, decimal_powers().power(level - 1)), lo);
+	}
+
+public:
+	/**
+	 *  @brief コンストラクタ
+	 *  @param[in] x  初期値
+	 */
+	BigInt(ll x = 0) : m_digits(), m_negative(x < 0) {
+		ull y = (x < 0 ? -static_cast<ull>(x) : static_cast<ull>(x));
+		for(; y > 0; y >>= 32){ m_digits.push_back(static_cast<unsigned int>(y)); }
+	}
+
+	/**
+	 *  @brief 10進表記からの変換
+	 *
+	 *  計算量は \f$ \mathcal{O}(M(n) \log{n}) \f$。
+	 *
+	 *  @param[in] s  10進表記 (先頭に符号 '+' または '-' を1つ付けてもよい)
+	 */
+	explicit BigInt(const string &s) : m_digits(), m_negative(false) {
+		size_t start = 0;
+		if(start < s.size() && (s[start] == '-' || s[start] == '+')){
+			m_negative = (s[start] == '-');
+			++start;
+		}
+		assert(start < s.size());
+		vector<unsigned int> chunks;
+		for(size_t end = s.size(); end > start; ){
+			const size_t begin = (end - start > 9 ? end - 9 : start);
+			unsigned int v = 0;
+			for(size_t i = begin; i < end; ++i){
+				assert('0' <= s[i] && s[i] <= '9');
+				v = v * 10 + (s[i] - '0');
+			}
+			chunks.push_back(v);
+			end = begin;
+		}
+		int level = 0;
+		while((1u << level) < chunks.size()){ ++level; }
+		m_digits = from_decimal(chunks, 0, level);
+		if(m_digits.empty()){ m_negative = false; }
+	}
+
+	/**
+	 *  @brief 10進表記への変換
+	 *
+	 *  計算量は \f$ \mathcal{O}(M(n) \log{n}) \f$。
+	 *
+	 *  @return 10進表記 (負の場合は先頭に '-' が付く)
+	 */
+	string to_string() const {
+		if(m_digits.empty()){ return "0"; }
+		int level = 0;
+		while(compare(m_digits, decimal_powers().power(level)) >= 0){ ++level; }
+		string s;
+		to_decimal(m_digits, level, s);
+		const size_t first = s.find_first_not_of('0');
+		return (m_negative ? "-" : "") + s.substr(first);
+	}
+
+	/**
+	 *  @brief 符号の取得
+	 *  @return 負なら -1、0なら 0、正なら 1
+	 */
+	int sign() const { return m_digits.empty() ? 0 : (m_negative ? -1 : 1); }
+
+	/**
+	 *  @brief 符号反転
+	 *  @return 符号を反転した値
+	 */
+	BigInt operator-() const { return BigInt(m_digits, !m_negative); }
+
+	/**
+	 *  @brief 多倍長整数同士の加算
+	 *  @param[in] x  加算する値
+	 *  @return    加算した結果
+	 */
+	BigInt operator+(const BigInt &x) const {
+		if(m_negative == x.m_negative){ return BigInt(add(m_digits, x.m_digits), m_negative); }
+		if(compare(m_digits, x.m_digits) >= 0){
+			return BigInt(sub(m_digits, x.m_digits), m_negative);
+		}
+		return BigInt(sub(x.m_digits, m_digits), x.m_negative);
+	}
+	/**
+	 *  @brief 多倍長整数同士の加算 + 代入
+	 *  @param[in] x  加算する値
+	 *  @return    自身への参照
+	 */
+	BigInt &operator+=(const BigInt &x){ return *this = *this + x; }
+
+	/**
+	 *  @brief 多倍長整数同士の減算
+	 *  @param[in] x  減算する値
+	 *  @return    減算した結果
+	 */
+	BigInt operator-(const BigInt &x) const { return *this + (-x); }
+	/**
+	 *  @brief 多倍長整数同士の減算 + 代入
+	 *  @param[in] x  減算する値
+	 *  @return    自身への参照
+	 */
+	BigInt &operator-=(const BigInt &x){ return *this = *this - x; }
+
+	/**
+	 *  @brief 多倍長整数同士の乗算
+	 *
+	 *  計算量は短い方の桁数 n が 32 以下で \f$ \mathcal{O}(n) \f$ 倍、
+	 *  1024 以下で \f$ \mathcal{O}(n^{0.59}) \f$ 倍、
+	 *  それより大きければ \f$ \mathcal{O}(n \log{n}) \f$。
+	 *
+	 *  @param[in] x  乗算する値
+	 *  @return    乗算した結果
+	 */
+	BigInt operator*(const BigInt &x) const {
+		return BigInt(multiply(m_digits, x.m_digits), m_negative != x.m_negative);
+	}
+	/**
+	 *  @brief 多倍長整数同士の乗算 + 代入
+	 *  @param[in] x  乗算する値
+	 *  @return    自身への参照
+	 */
+	BigInt &operator*=(const BigInt &x){ return *this = *this * x; }
+
+	/**
+	 *  @brief 多倍長整数同士の除算
+	 *
+	 *  商は0に向かって切り捨てる。
+	 *  計算量は \f$ \mathcal{O}(M(n)) \f$。
+	 *
+	 *  @param[in] x  除算する値 (0以外)
+	 *  @return    除算した結果
+	 */
+	BigInt operator/(const BigInt &x) const {
+		Digits q, r;
+		divide(m_digits, x.m_digits, q, r);
+		return BigInt(q, m_negative != x.m_negative);
+	}
+	/**
+	 *  @brief 多倍長整数同士の除算 + 代入
+	 *  @param[in] x  除算する値 (0以外)
+	 *  @return    自身への参照
+	 */
+	BigInt &operator/=(const BigInt &x){ return *this = *this / x; }
+
+	/**
+	 *  @brief 多倍長整数同士の剰余
+	 *
+	 *  結果の符号は自身の符号と一致する。
+	 *  計算量は \f$ \mathcal{O}(M(n)) \f$。
+	 *
+	 *  @param[in] x  除算する値 (0以外)
+	 *  @return    剰余
+	 */
+	BigInt operator%(const BigInt &x) const {
+		Digits q, r;
+		divide(m_digits, x.m_digits, q, r);
+		return BigInt(r, m_negative);
+	}
+	/**
+	 *  @brief 多倍長整数同士の剰余 + 代入
+	 *  @param[in] x  除算する値 (0以外)
+	 *  @return    自身への参照
+	 */
+	BigInt &operator%=(const BigInt &x){ return *this = *this % x; }
+
+	/**
+	 *  @brief 多倍長整数同士の比較 (==)
+	 *  @param[in] x      比較する値
+	 *  @retval    true   (*this) == x の場合
+	 *  @retval    false  (*this) != x の場合
+	 */
+	bool operator==(const BigInt &x) const {
+		return m_negative == x.m_negative && m_digits == x.m_digits;
+	}
+	/**
+	 *  @brief 多倍長整数同士の比較 (!=)
+	 *  @param[in] x      比較する値
+	 *  @retval    true   (*this) != x の場合
+	 *  @retval    false  (*this) == x の場合
+	 */
+	bool operator!=(const BigInt &x) const { return !(*this == x); }
+	/**
+	 *  @brief 多倍長整数同士の比較 (<)
+	 *  @param[in] x      比較する値
+	 *  @retval    true   (*this) < x の場合
+	 *  @retval    false  (*this) >= x の場合
+	 */
+	bool operator<(const BigInt &x) const {
+		if(m_negative != x.m_negative){ return m_negative; }
+		const int c = compare(m_digits, x.m_digits);
+		return m_negative ? c > 0 : c < 0;
+	}
+	/**
+	 *  @brief 多倍長整数同士の比較 (<=)
+	 *  @param[in] x      比較する値
+	 *  @retval    true   (*this) <= x の場合
+	 *  @retval    false  (*this) > x の場合
+	 */
+	bool operator<=(const BigInt &x) const { return !(x < *this); }
+	/**
+	 *  @brief 多倍長整数同士の比較 (>)
+	 *  @param[in] x      比較する値
+	 *  @retval    true   (*this) > x の場合
+	 *  @retval    false  (*this) <= x の場合
+	 */
+	bool operator>(const BigInt &x) const { return x < *this; }
+	/**
+	 *  @brief 多倍長整数同士の比較 (>=)
+	 *  @param[in] x      比較する値
+	 *  @retval    true   (*this) >= x の場合
+	 *  @retval    false  (*this) < x の場合
+	 */
+	bool operator>=(const BigInt &x) const { return !(*this < x); }
+
+};
+
+/**
+ *  @brief 多倍長整数の出力
+ *  @param[in,out] os  出力先ストリーム
+ *  @param[in]     x   出力する値
+ *  @return 出力先ストリーム
+ */
+inline ostream &operator<<(ostream &os, const BigInt &x){
+	return os << x.to_string();
+}
+
+/**
+ *  @}
+ */
+
+}
+}
@@ -0,0 +1,331 @@
+/**
+ *  @file math/binary_matrix.h
+ */
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <cassert>
+#include "common/header.h"
+
+namespace libcomp {
+namespace math {
+
+/**
+ *  @defgroup binary_matrix Binary matrix
+ *  @ingroup  math
+ *  @{
+ */
+
+/**
+ *  @brief ビット列同士の排他的論理和
+ *
+ *  dst[i] ^= src[i] (0 <= i < n) を計算する。
+ *  GCC/Clang ではベクトル拡張を用いて4ワードずつ処理する。
+ *
+ *  @param[in,out] dst  更新するワード列
+ *  @param[in]     src  排他的論理和を取るワード列
+ *  @param[in]     n    ワード数
+ */
+inline void xor_words(ull *dst, const ull *src, int n){
+	int i = 0;
+#ifdef __GNUC__
+	typedef ull block_type __attribute__((vector_size(32)));
+	for(; i + 4 <= n; i += 4){
+		block_type a, b;
+		memcpy(&a, dst + i, sizeof(a));
+		memcpy(&b, src + i, sizeof(b));
+		a ^= b;
+		memcpy(dst + i, &a, sizeof(a));
+	}
+#endif
+	for(; i < n; ++i){ dst[i] ^= src[i]; }
+}
+
+/**
+ *  @brief GF(2) 上の行列
+ *
+ *  各行を64bitワードの列として詰めて保持する行列型。
+ *  行の加算 (排他的論理和) はワード単位で行う。
+ *  掃き出しには Method of Four Russians を用い、
+ *  K 列ごとにピボット行の全組み合わせの表を作って
+ *  各行の消去を1回の表引きと排他的論理和で済ませる。
+ */
+class BinaryMatrix {
+
+private:
+	static const int K = 8;
+
+	int N, M, W;
+	vector<ull> data;
+
+	ull *row(int i){ return &data[static_cast<size_t>(i) * W]; }
+	const ull *row(int i) const { return &data[static_cast<size_t>(i) * W]; }
+
+	void swap_rows(int a, int b){
+		if(a == b){ return; }
+		swap_ranges(row(a), row(a) + W, row(b));
+	}
+
+public:
+	/**
+	 *  @brief コンストラクタ
+	 *
+	 *  すべての要素が0の行列を構築する。
+	 *
+	 *  @param[in] N  行列の行数
+	 *  @param[in] M  行列の列数
+	 */
+	BinaryMatrix(int N, int M) :
+		N(N), M(M), W((M + 63) / 64), data(static_cast<size_t>(N) * W)
+	{ }
+
+	/**
+	 *  @brief 行列の行数の取得
+	 *  @return 行列の行数
+	 */
+	int rows() const { return N; }
+	/**
+	 *  @brief 行列の列数の取得
+	 *  @return 行列の列数
+	 */
+	int columns() const { return M; }
+
+	/**
+	 *  @brief 要素の取得
+	 *  @param[in] i  行番号
+	 *  @param[in] j  列番号
+	 *  @return    (i, j) 要素の値 (0または1)
+	 */
+	int get(int i, int j) const { return (row(i)[j >> 6] >> (j & 63)) & 1; }
+
+	/**
+	 *  @brief 要素の設定
+	 *  @param[in] i  行番号
+	 *  @param[in] j  列番号
+	 *  @param[in] v  設定する値 (0または1)
+	 */
+	void set(int i, int j, int v){
+		const ull bit = 1ull << (j & 63);
+		if(v){
+			row(i)[j >> 6] |= bit;
+		}else{
+			row(i)[j >> 6] &= ~bit;
+		}
+	}
+
+	/**
+	 *  @brief 行への加算
+	 *
+	 *  i行目にj行目を加算 (排他的論理和) する。
+	 *  計算量は \f$ \mathcal{O}(M / w) \f$。
+	 *
+	 *  @param[in] i  加算される行
+	 *  @param[in] j  加算する行
+	 */
+	void add_row(int i, int j){ xor_words(row(i), row(j), W); }
+
+	/**
+	 *  @brief 行簡約階段形への変形
+	 *
+	 *  行列を掃き出して行簡約階段形に変形する。
+	 *  計算量は \f$ \mathcal{O}(N M \min(N, M) / (w \log{N})) \f$ 程度。
+	 *
+	 *  @param[out] pivots  各ピボット行のピボット列 (NULLなら出力しない)
+	 *  @return     行列の階数
+	 */
+	int eliminate(vector<int> *pivots = NULL){
+		vector<ull> table(static_cast<size_t>(1 << K) * W);
+		vector<int> block_rows, block_columns;
+		if(pivots){ pivots->clear(); }
+		int r = 0;
+		for(int c0 = 0; c0 < M && r < N; c0 += K){
+			const int c1 = min(c0 + K, M), w0 = c0 >> 6;
+			block_rows.clear();
+			block_columns.clear();
+			// ブロック内のピボットを通常の掃き出しで求める
+			for(int c = c0; c < c1 && r + static_cast<int>(block_rows.size()) < N; ++c){
+				const int top = r + block_rows.size();
+				int found = -1;
+				for(int i = top; i < N && found < 0; ++i){
+					for(size_t k = 0; k < block_rows.size(); ++k){
+						if(get(i, block_columns[k])){
+							xor_words(row(i) + w0, row(block_rows[k]) + w0, W - w0);
+						}
+					}
+					if(get(i, c)){ found = i; }
+				}
+				if(found < 0){ continue; }
+				swap_rows(found, top);
+				for(size_t k = 0; k < block_rows.size(); ++k){
+					if(get(block_rows[k], c)){
+						xor_words(row(block_rows[k]) + w0, row(top) + w0, W - w0);
+					}
+				}
+				block_rows.push_back(top);
+				block_columns.push_back(c);
+			}
+			const int k = block_rows.size();
+			if(k == 0){ continue; }
+			// ピボット行の全組み合わせの表を作る
+			for(int mask = 1; mask < (1 << k); ++mask){
+				ull *dst = &table[static_cast<size_t>(mask) * W];
+				const ull *prev = &table[static_cast<size_t>(mask & (mask - 1)) * W];
+				const ull *src = row(block_rows[__builtin_ctz(mask)]);
+				for(int w = w0; w < W; ++w){ dst[w] = prev[w] ^ src[w]; }
+			}
+			// 他のすべての行からピボット列を消去する
+			for(int i = 0; i < N; ++i){
+				if(r <= i && i < r + k){ continue; }
+				int mask = 0;
+				for(int j = 0; j < k; ++j){ mask |= get(i, block_columns[j]) << j; }
+				if(mask){
+					xor_words(row(i) + w0, &table[static_cast<size_t>(mask) * W] + w0, W - w0);
+				}
+			}
+			if(pivots){ pivots->insert(pivots->end(), block_columns.begin(), block_columns.end()); }
+			r += k;
+		}
+		return r;
+	}
+
+	/**
+	 *  @brief 行列の階数
+	 *
+	 *  計算量は eliminate と同じ。
+	 *
+	 *  @return 行列の階数
+	 */
+	int rank() const {
+		BinaryMatrix a(*this);
+		return a.eliminate();
+	}
+
+	/**
+	 *  @brief 連立1次方程式の求解
+	 *
+	 *  GF(2) 上の方程式 \f$ Ax = b \f$ の解を1つ求める。
+	 *  自由変数はすべて0とする。
+	 *
+	 *  @param[in] b  右辺値 (大きさN、各要素は0または1)
+	 *  @return    方程式の解 (大きさM)。解が存在しない場合は空のベクタを返す。
+	 */
+	vector<int> solve(const vector<int> &b) const {
+		assert(static_cast<int>(b.size()) == N);
+		BinaryMatrix a(N, M + 1);
+		for(int i = 0; i < N; ++i){
+			copy(row(i), row(i) + W, a.row(i));
+			a.set(i, M, b[i] & 1);
+		}
+		vector<int> pivots;
+		const int r = a.eliminate(&pivots);
+		if(r > 0 && pivots[r - 1] == M){ return vector<int>(); }
+		vector<int> x(M);
+		for(int i = 0; i < r; ++i){ x[pivots[i]] = a.get(i, M); }
+		return x;
+	}
+
+};
+
+/**
+ *  @brief GF(2) 上の線形基底
+ *
+ *  bits ビットのベクトルの集合が張る空間を管理する。
+ *  各基底ベクトルは最下位の立っているビットをピボットとして、
+ *  ピボットごとに高々1本だけ保持する。
+ *  ベクトルは64bitワードの列 (ビット j はワード j / 64 の j % 64 ビット目) で表す。
+ */
+class BinaryLinearBasis {
+
+private:
+	int W;
+	vector<ull> m_rows;
+	vector<int> m_index;
+	int m_size;
+
+public:
+	/**
+	 *  @brief コンストラクタ
+	 *  @param[in] bits  ベクトルのビット数
+	 */
+	explicit BinaryLinearBasis(int bits) :
+		W((bits + 63) / 64), m_rows(), m_index(bits, -1), m_size(0)
+	{ }
+
+	/**
+	 *  @brief 基底の大きさの取得
+	 *  @return 張られる空間の次元
+	 */
+	int size() const { return m_size; }
+
+	/**
+	 *  @brief ベクトルの簡約
+	 *
+	 *  vから基底ベクトルを取り除いた代表元に置き換える。
+	 *  vが空間に含まれていれば0になる。
+	 *  計算量は \f$ \mathcal{O}(r \cdot \mathit{bits} / w) \f$ (rは基底の大きさ)。
+	 *
+	 *  @param[in,out] v  簡約するベクトル (W ワード)
+	 */
+	void reduce(vector<ull> &v) const {
+		assert(static_cast<int>(v.size()) == W);
+		for(int w = 0; w < W; ++w){
+			ull bits = v[w];
+			while(bits){
+				const int b = __builtin_ctzll(bits);
+				const int k = m_index[w * 64 + b];
+				if(k < 0){
+					bits &= bits - 1;
+					continue;
+				}
+				xor_words(&v[w], &m_rows[static_cast<size_t>(k) * W + w], W - w);
+				bits = v[w] & ~((2ull << b) - 1);
+			}
+		}
+	}
+
+	/**
+	 *  @brief ベクトルの追加
+	 *
+	 *  計算量は reduce と同じ。
+	 *
+	 *  @param[in] v  追加するベクトル (W ワード)
+	 *  @retval    true   vが既存の基底と線形独立であり、基底が拡張された
+	 *  @retval    false  vは既に空間に含まれていた
+	 */
+	bool insert(vector<ull> v){
+		reduce(v);
+		for(int w = 0; w < W; ++w){
+			if(v[w] == 0){ continue; }
+			m_index[w * 64 + __builtin_ctzll(v[w])] = m_size++;
+			m_rows.insert(m_rows.end(), v.begin(), v.end());
+			return true;
+		}
+		return false;
+	}
+
+	/**
+	 *  @brief ベクトルの所属判定
+	 *
+	 *  計算量は reduce と同じ。
+	 *
+	 *  @param[in] v  判定するベクトル (W ワード)
+	 *  @retval    true   vは空間に含まれる
+	 *  @retval    false  vは空間に含まれない
+	 */
+	bool contains(vector<ull> v) const {
+		reduce(v);
+		for(int w = 0; w < W; ++w){
+			if(v[w] != 0){ return false; }
+		}
+		return true;
+	}
+
+};
+
+/**
+ *  @}
+ */
+
+}
+}
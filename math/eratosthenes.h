@@ -3,6 +3,7 @@
  */
 #pragma once
 #include <vector>
+#include <algorithm>
 #include "common/header.h"
 
 namespace libcomp {
@@ -52,6 +53,171 @@ vector<int> eratosthenes(int n){
 	return eratosthenes(sieve);
 }
 
+/**
+ *  @brief 区間分割・ビット圧縮・車輪分解を用いたエラトステネスの篩
+ *
+ *  [low, high) の範囲に含まれる素数を昇順に列挙し、それぞれについて f(p) を呼び出す。
+ *  30 と互いに素な8つの剰余類 {1, 7, 11, 13, 17, 19, 23, 29} のみを保持し、
+ *  30個の整数を1バイトで表す。範囲は SEGMENT バイト (L1キャッシュ程度) ずつに区切って篩い、
+ *  7, 11, 13 の倍数は周期 1001 バイトの型を複写して取り除く。
+ *  17 以上の篩う素数ごとに次の倍数の位置と車輪上の位置を保持し、
+ *  区間を跨いで倍数の列挙を継続する。
+ *  使用する記憶領域は区間の大きさと \f$ \sqrt{\mathit{high}} \f$ 以下の素数の個数に比例する。
+ *  計算量は \f$ \mathcal{O}((\mathit{high} - \mathit{low}) \log{\log{\mathit{high}}} + \sqrt{\mathit{high}}) \f$ 程度。
+ *
+ *  @tparam    Function  素数を受け取る関数の型
+ *  @param[in] low       範囲の下限
+ *  @param[in] high      範囲の上限
+ *  @param[in] f         見つけた素数ごとに呼び出す関数
+ */
+template <typename Function>
+void segmented_eratosthenes(ll low, ll high, Function f){
+	static const int SEGMENT = 1 << 15;
+	static const int PATTERN = 7 * 11 * 13;
+	struct Wheel {
+		int residues[9];
+		int gaps[8];
+		int index[30];
+		// 素数 p ≡ residues[r] と倍数 q ≡ residues[k] (mod 30) について
+		// pq の位置のビットを落とすマスクと、次の倍数までのバイト数の補正値
+		unsigned char masks[8][8];
+		int steps[8][8];
+		int offsets[8][8];
+		int values[64];
+		unsigned char pattern[PATTERN];
+
+		Wheel(){
+			const int r[9] = { 1, 7, 11, 13, 17, 19, 23, 29, 31 };
+			copy(r, r + 9, residues);
+			fill(index, index + 30, -1);
+			for(int k = 0; k < 8; ++k){
+				gaps[k] = residues[k + 1] - residues[k];
+				index[residues[k]] = k;
+			}
+			for(int i = 0; i < 8; ++i){
+				const int p = residues[i];
+				for(int k = 0; k < 8; ++k){
+					masks[i][k] = ~(1 << index[p * residues[k] % 30]);
+					steps[i][k] = p * residues[k + 1] / 30 - p * residues[k] / 30;
+					offsets[i][k] = p * residues[k] / 30;
+				}
+			}
+			for(int t = 0; t < 64; ++t){ values[t] = 30 * (t >> 3) + residues[t & 7]; }
+			for(int i = 0; i < PATTERN; ++i){
+				pattern[i] = 0;
+				for(int k = 0; k < 8; ++k){
+					const int v = 30 * i + residues[k];
+					if(v % 7 && v % 11 && v % 13){ pattern[i] |= 1 << k; }
+				}
+			}
+		}
+	};
+	struct SievingPrime {
+		ll offset;
+		unsigned int quotient;
+		unsigned char r;
+		unsigned char k;
+	};
+	static const Wheel wheel;
+	low = max(low, 0ll);
+	if(low >= high){ return; }
+	const ll small[] = { 2, 3, 5 };
+	for(int i = 0; i < 3; ++i){
+		if(low <= small[i] && small[i] < high){ f(small[i]); }
+	}
+	ll root = 1;
+	while((root + 1) * (root + 1) < high){ ++root; }
+	const ll first = low / 30, last = (high + 29) / 30;
+	vector<SievingPrime> primes;
+	{
+		vector<bool> sieve(root + 1);
+		for(ll p = 2; p <= root; ++p){
+			if(sieve[p]){ continue; }
+			for(ll j = p * p; j <= root; j += p){ sieve[j] = true; }
+			if(p < 17){ continue; }
+			// 最初の倍数 pq (q >= p、q は30と互いに素) の位置
+			ll q = max(p, (low + p - 1) / p);
+			while(wheel.index[q % 30] < 0){ ++q; }
+			SievingPrime sp;
+			sp.offset = p * q / 30 - first;
+			sp.quotient = p / 30;
+			sp.r = wheel.index[p % 30];
+			sp.k = wheel.index[q % 30];
+			primes.push_back(sp);
+		}
+	}
+	vector<unsigned char> segment(SEGMENT + 8);
+	for(ll start = first; start < last; start += SEGMENT){
+		const int len = static_cast<int>(min<ll>(SEGMENT, last - start));
+		unsigned char *s = segment.data();
+		for(int i = 0, j = start % PATTERN; i < len; ){
+			const int c = min(len - i, PATTERN - j);
+			copy(wheel.pattern + j, wheel.pattern + j + c, s + i);
+			i += c;
+			j = 0;
+		}
+		fill(s + len, s + SEGMENT + 8, 0);
+		if(start == 0){ s[0] = (s[0] | 0x0e) & 0xfe; }
+		for(size_t i = 0; i < primes.size(); ++i){
+			SievingPrime &sp = primes[i];
+			const unsigned char *masks = wheel.masks[sp.r];
+			const int *steps = wheel.steps[sp.r];
+			const unsigned int a = sp.quotient;
+			ll o = sp.offset;
+			int k = sp.k;
+			for(; k != 0 && o < len; k = (k + 1) & 7){
+				s[o] &= masks[k];
+				o += a * wheel.gaps[k] + steps[k];
+			}
+			if(k == 0){
+				// 車輪を1周すると p バイト進む
+				const ll p = 30ll * a + wheel.residues[sp.r];
+				const int *d = wheel.offsets[sp.r];
+				const ll d1 = a * 6 + d[1], d2 = a * 10 + d[2], d3 = a * 12 + d[3];
+				const ll d4 = a * 16 + d[4], d5 = a * 18 + d[5], d6 = a * 22 + d[6];
+				const ll d7 = a * 28 + d[7];
+				for(; o + p <= len; o += p){
+					unsigned char *t = s + o;
+					t[0] &= masks[0]; t[d1] &= masks[1];
+					t[d2] &= masks[2]; t[d3] &= masks[3];
+					t[d4] &= masks[4]; t[d5] &= masks[5];
+					t[d6] &= masks[6]; t[d7] &= masks[7];
+				}
+			}
+			for(; o < len; k = (k + 1) & 7){
+				s[o] &= masks[k];
+				o += a * wheel.gaps[k] + steps[k];
+			}
+			sp.offset = o - len;
+			sp.k = k;
+		}
+		const ll base = 30 * start;
+		for(int i = 0; i < len; i += 8){
+			ull bits = 0;
+			for(int j = 7; j >= 0; --j){ bits = (bits << 8) | s[i + j]; }
+			for(; bits; bits &= bits - 1){
+				const ll v = base + 30 * i + wheel.values[__builtin_ctzll(bits)];
+				if(low <= v && v < high){ f(v); }
+			}
+		}
+	}
+}
+
+/**
+ *  @brief 区間分割・ビット圧縮・車輪分解を用いたエラトステネスの篩
+ *
+ *  [0, n) の範囲に含まれる素数を昇順に列挙し、それぞれについて f(p) を呼び出す。
+ *  計算量は \f$ \mathcal{O}(n \log{\log{n}}) \f$ 程度。
+ *
+ *  @tparam    Function  素数を受け取る関数の型
+ *  @param[in] n         範囲の上限
+ *  @param[in] f         見つけた素数ごとに呼び出す関数
+ */
+template <typename Function>
+void segmented_eratosthenes(ll n, Function f){
+	segmented_eratosthenes(0, n, f);
+}
+
 /**
  *  @}
  */
@@ -4,7 +4,13 @@
 #pragma once
 #include "common/header.h"
 #include <complex>
+#include <vector>
+#include <memory>
 #include <algorithm>
+#include <type_traits>
+#include <cmath>
+#include <cassert>
+#include "misc/thread_pool.h"
 
 namespace libcomp {
 namespace math {
@@ -15,44 +21,509 @@ namespace math {
  *  @{
  */
 
+/**
+ *  @brief 高速フーリエ変換の計画
+ *
+ *  大きさnの変換に用いる回転因子の表とビット反転置換を構築時に求めて保持する。
+ *  回転因子は段ごとに連続した領域に並べてあり、
+ *  長さ 2k のバタフライは \f$ e^{i \pi j / k} \f$ (0 <= j < k) を
+ *  添字 k + j から順に読み出す。
+ *  順変換は \f$ X_k = \sum_j x_j e^{2 \pi i jk / n} \f$ とし、
+ *  逆変換は符号を反転して 1/n 倍する。
+ *  構築の計算量は \f$ \mathcal{O}(n) \f$。
+ */
+class FFTPlan {
+
+private:
+	int m_size;
+	int m_log;
+	vector<int> m_rev;
+	vector< complex<double> > m_roots;
+
+	static complex<double> mul(const complex<double> &a, const complex<double> &b){
+		return complex<double>(
+			a.real() * b.real() - a.imag() * b.imag(),
+			a.real() * b.imag() + a.imag() * b.real());
+	}
+
+	// 先頭 m = n >> shift 要素に対する変換
+	void transform(complex<double> *a, int shift, bool inverse) const {
+		const int m = m_size >> shift;
+		for(int i = 0; i < m; ++i){
+			const int j = m_rev[i] >> shift;
+			if(i < j){ swap(a[i], a[j]); }
+		}
+		for(int k = 1; k < m; k <<= 1){
+			const complex<double> *w = &m_roots[k];
+			for(int i = 0; i < m; i += 2 * k){
+				complex<double> *x = a + i, *y = a + i + k;
+				for(int j = 0; j < k; ++j){
+					const complex<double> z = mul(w[j], y[j]);
+					y[j] = x[j] - z;
+					x[j] += z;
+				}
+			}
+		}
+		if(inverse){
+			reverse(a + 1, a + m);
+			const double r = 1.0 / m;
+			for(int i = 0; i < m; ++i){ a[i] *= r; }
+		}
+	}
+
+public:
+	/**
+	 *  @brief コンストラクタ
+	 *  @param[in] n  変換の大きさ (2のべき乗であること)
+	 */
+	explicit FFTPlan(int n) :
+		m_size(n), m_log(0), m_rev(n), m_roots(max(n, 2))
+	{
+		assert(n > 0 && (n & (n - 1)) == 0);
+		while((1 << m_log) < n){ ++m_log; }
+		for(int i = 1; i < n; ++i){
+			m_rev[i] = (m_rev[i >> 1] >> 1) | ((i & 1) << (m_log - 1));
+		}
+		m_roots[1] = 1.0;
+		for(int k = 2; k < n; k <<= 1){
+			for(int j = 0; j < k; ++j){ m_roots[k + j] = polar(1.0, M_PI * j / k); }
+		}
+	}
+
+	/**
+	 *  @brief 変換の大きさの取得
+	 *  @return 変換の大きさ
+	 */
+	int size() const { return m_size; }
+
+	/**
+	 *  @brief 複素数列の変換
+	 *
+	 *  計算量は \f$ \mathcal{O}(n \log{n}) \f$。
+	 *
+	 *  @param[in,out] a        変換する列 (大きさn)。結果で上書きされる。
+	 *  @param[in]     inverse  逆変換を行う場合にtrueを指定する
+	 */
+	void transform(complex<double> *a, bool inverse = false) const {
+		transform(a, 0, inverse);
+	}
+
+	/**
+	 *  @brief 実数列の変換
+	 *
+	 *  偶数番目と奇数番目の要素をそれぞれ実部と虚部に詰めた
+	 *  大きさ n/2 の複素数列を変換し、その結果から実数列の変換を復元する。
+	 *  変換結果はエルミート対称なので前半の n/2+1 要素のみを出力する。
+	 *  計算量は \f$ \mathcal{O}(n \log{n}) \f$。
+	 *
+	 *  @param[in]  src  変換する実数列 (大きさn、n >= 2)
+	 *  @param[out] dst  変換結果の出力先 (大きさ n/2+1)
+	 */
+	void real_transform(const double *src, complex<double> *dst) const {
+		assert(m_size >= 2);
+		const int m = m_size >> 1;
+		for(int j = 0; j < m; ++j){ dst[j] = complex<double>(src[2 * j], src[2 * j + 1]); }
+		transform(dst, 1, false);
+		const complex<double> i_half(0.0, 0.5);
+		const complex<double> z0 = dst[0];
+		dst[0] = z0.real() + z0.imag();
+		dst[m] = z0.real() - z0.imag();
+		for(int k = 1; 2 * k <= m; ++k){
+			const complex<double> zk = dst[k], zl = conj(dst[m - k]);
+			const complex<double> e = 0.5 * (zk + zl);
+			const complex<double> o = mul(m_roots[m + k], -i_half * (zk - zl));
+			dst[k] = e + o;
+			dst[m - k] = conj(e - o);
+		}
+	}
+
+	/**
+	 *  @brief 実数列の逆変換
+	 *
+	 *  real_transform の逆変換。
+	 *  計算量は \f$ \mathcal{O}(n \log{n}) \f$。
+	 *
+	 *  @param[in]  src  変換結果の前半 (大きさ n/2+1)
+	 *  @param[out] dst  復元した実数列の出力先 (大きさn)
+	 */
+	void inverse_real_transform(const complex<double> *src, double *dst) const {
+		assert(m_size >= 2);
+		const int m = m_size >> 1;
+		// complex<double> は double[2] と同じ配置であることが保証されている
+		complex<double> *z = reinterpret_cast<complex<double> *>(dst);
+		const complex<double> i_unit(0.0, 1.0);
+		z[0] = 0.5 * (src[0] + conj(src[m])) + 0.5 * i_unit * (src[0] - conj(src[m]));
+		for(int k = 1; 2 * k <= m; ++k){
+			const complex<double> xk = src[k], xl = conj(src[m - k]);
+			const complex<double> e = 0.5 * (xk + xl);
+			const complex<double> o = mul(conj(m_roots[m + k]), 0.5 * (xk - xl));
+			z[k] = e + i_unit * o;
+			z[m - k] = conj(e) + i_unit * conj(o);
+		}
+		transform(z, 1, true);
+	}
+
+	/**
+	 *  @brief 共有された計画の取得
+	 *
+	 *  スレッドごとに大きさ別の計画を保持し、同じ大きさの変換で使い回す。
+	 *
+	 *  @param[in] n  変換の大きさ (2のべき乗であること)
+	 *  @return    大きさnの計画
+	 */
+	static const FFTPlan &shared(int n){
+		static thread_local vector< unique_ptr<FFTPlan> > cache;
+		const int k = __builtin_ctz(n);
+		if(static_cast<int>(cache.size()) <= k){ cache.resize(k + 1); }
+		if(!cache[k]){ cache[k].reset(new FFTPlan(n)); }
+		return *cache[k];
+	}
+
+};
+
+/**
+ *  @brief 四段階法による大きさの大きい高速フーリエ変換の計画
+ *
+ *  \f$ n = n_1 n_2 \f$ (\f$ n_1 \approx n_2 \approx \sqrt{n} \f$) として、
+ *  入力を \f$ n_2 \f$ 行 \f$ n_1 \f$ 列の行列とみなし、
+ *  各列の大きさ \f$ n_2 \f$ の変換、回転因子 \f$ e^{2 \pi i j_1 k_2 / n} \f$ の乗算、
+ *  各列の大きさ \f$ n_1 \f$ の変換の順に計算する。
+ *  列は BLOCK 列ずつ作業領域に転置しながら集めて変換するため、
+ *  個々の変換はキャッシュに収まり、主記憶へのアクセスは連続した領域単位となる。
+ *  1段目の結果は転置して書き出すことで、2段目の出力が自然な順序になる。
+ *  列ブロックごとの処理は独立しているため、スレッドプールで並列に実行できる。
+ *  符号と正規化は FFTPlan と同じ。
+ */
+class FourStepFFTPlan {
+
+private:
+	static const int BLOCK = 8;
+
+	int m_size;
+	int m_width;
+	int m_height;
+	int m_shift;
+	FFTPlan m_width_plan;
+	FFTPlan m_height_plan;
+	vector< complex<double> > m_low;
+	vector< complex<double> > m_high;
+
+	static int width_of(int n){
+		assert(n > 0 && (n & (n - 1)) == 0);
+		return 1 << (__builtin_ctz(n) / 2);
+	}
+
+	// e^{2 pi i e / n} (0 <= e < n)
+	complex<double> twiddle(int e) const {
+		const complex<double> &a = m_high[e >> m_shift];
+		const complex<double> &b = m_low[e & ((1 << m_shift) - 1)];
+		return complex<double>(
+			a.real() * b.real() - a.imag() * b.imag(),
+			a.real() * b.imag() + a.imag() * b.real());
+	}
+
+	template <typename Function>
+	static void for_each(int count, Function f, misc::ThreadPool *pool){
+		if(pool){
+			pool->parallel_for(0, count, f);
+		}else{
+			for(int i = 0; i < count; ++i){ f(i); }
+		}
+	}
+
+	static complex<double> *workspace(int size){
+		static thread_local vector< complex<double> > buffer;
+		if(static_cast<int>(buffer.size()) < size){ buffer.resize(size); }
+		return buffer.data();
+	}
+
+	// src の列 [c, c + cnt) を変換し、回転因子を掛けて dst の行として書き出す
+	void first_step(
+		complex<double> *dst, const complex<double> *src, int c, bool inverse) const
+	{
+		const int w = m_width, h = m_height;
+		const int cnt = (w - c < BLOCK ? w - c : BLOCK);
+		complex<double> *buf = workspace(BLOCK * h);
+		for(int j = 0; j < h; ++j){
+			const complex<double> *row = src + static_cast<ll>(j) * w + c;
+			for(int b = 0; b < cnt; ++b){ buf[b * h + j] = row[b]; }
+		}
+		for(int b = 0; b < cnt; ++b){
+			complex<double> *x = buf + b * h;
+			complex<double> *y = dst + static_cast<ll>(c + b) * h;
+			m_height_plan.transform(x, inverse);
+			for(int k = 0, e = 0; k < h; ++k, e += c + b){
+				const complex<double> t = (inverse ? conj(twiddle(e)) : twiddle(e));
+				y[k] = complex<double>(
+					x[k].real() * t.real() - x[k].imag() * t.imag(),
+					x[k].real() * t.imag() + x[k].imag() * t.real());
+			}
+		}
+	}
+
+	// a の列 [c, c + cnt) をその場で変換する
+	void second_step(complex<double> *a, int c, bool inverse) const {
+		const int w = m_width, h = m_height;
+		const int cnt = (h - c < BLOCK ? h - c : BLOCK);
+		complex<double> *buf = workspace(BLOCK * w);
+		for(int j = 0; j < w; ++j){
+			const complex<double> *row = a + static_cast<ll>(j) * h + c;
+			for(int b = 0; b < cnt; ++b){ buf[b * w + j] = row[b]; }
+		}
+		for(int b = 0; b < cnt; ++b){ m_width_plan.transform(buf + b * w, inverse); }
+		for(int k = 0; k < w; ++k){
+			complex<double> *row = a + static_cast<ll>(k) * h + c;
+			for(int b = 0; b < cnt; ++b){ row[b] = buf[b * w + k]; }
+		}
+	}
+
+public:
+	/**
+	 *  @brief コンストラクタ
+	 *
+	 *  計算量は \f$ \mathcal{O}(\sqrt{n}) \f$。
+	 *
+	 *  @param[in] n  変換の大きさ (2のべき乗であること)
+	 */
+	explicit FourStepFFTPlan(int n) :
+		m_size(n), m_width(width_of(n)), m_height(n / m_width), m_shift(0),
+		m_width_plan(m_width), m_height_plan(m_height), m_low(), m_high()
+	{
+		m_shift = __builtin_ctz(n) / 2;
+		m_low.resize(1 << m_shift);
+		m_high.resize(n >> m_shift);
+		for(size_t i = 0; i < m_low.size(); ++i){
+			m_low[i] = polar(1.0, 2.0 * M_PI * i / n);
+		}
+		for(size_t i = 0; i < m_high.size(); ++i){
+			m_high[i] = polar(1.0, 2.0 * M_PI * (static_cast<double>(i) * (1 << m_shift)) / n);
+		}
+	}
+
+	/**
+	 *  @brief 変換の大きさの取得
+	 *  @return 変換の大きさ
+	 */
+	int size() const { return m_size; }
+
+	/**
+	 *  @brief 複素数列の変換
+	 *
+	 *  poolを指定した場合は列ブロックごとの変換を並列に実行する。
+	 *  計算量は \f$ \mathcal{O}(n \log{n}) \f$。
+	 *
+	 *  @param[out] dst      変換結果の出力先 (大きさn、srcと重なってはならない)
+	 *  @param[in]  src      変換する列 (大きさn)
+	 *  @param[in]  inverse  逆変換を行う場合にtrueを指定する
+	 *  @param[in]  pool     並列化に用いるスレッドプール (NULLなら逐次実行)
+	 */
+	void transform(
+		complex<double> *dst, const complex<double> *src, bool inverse = false,
+		misc::ThreadPool *pool = NULL) const
+	{
+		assert(dst + m_size <= src || src + m_size <= dst);
+		const int w = m_width, h = m_height;
+		for_each((w + BLOCK - 1) / BLOCK, [&](int i){
+			first_step(dst, src, i * BLOCK, inverse);
+		}, pool);
+		for_each((h + BLOCK - 1) / BLOCK, [&](int i){
+			second_step(dst, i * BLOCK, inverse);
+		}, pool);
+	}
+
+	/**
+	 *  @brief 共有された計画の取得
+	 *
+	 *  スレッドごとに大きさ別の計画を保持し、同じ大きさの変換で使い回す。
+	 *
+	 *  @param[in] n  変換の大きさ (2のべき乗であること)
+	 *  @return    大きさnの計画
+	 */
+	static const FourStepFFTPlan &shared(int n){
+		static thread_local vector< unique_ptr<FourStepFFTPlan> > cache;
+		const int k = __builtin_ctz(n);
+		if(static_cast<int>(cache.size()) <= k){ cache.resize(k + 1); }
+		if(!cache[k]){ cache[k].reset(new FourStepFFTPlan(n)); }
+		return *cache[k];
+	}
+
+};
+
 /**
  *  @brief 高速フーリエ変換
  *
  *  Cooley-Tukey法による高速フーリエ変換。
+ *  大きさが \f$ 2^{20} \f$ 以上の場合は、
+ *  キャッシュに収まらない列への主記憶アクセスを減らすため
+ *  四段階法 (FourStepFFTPlan) を用いる。
+ *  同じ大きさの変換を繰り返す場合は FFTPlan を直接用いること。
  *  計算量は \f$ \mathcal{O}(n \log{n}) \f$
  *
- *  @param[out] dst  変換結果の出力先バッファ
- *  @param[in]  src  入力データの先頭を指すポインタ
- *  @param[in]  n    入力データのサイズ (2のべき乗であること)
- *  @param[in]  inv  逆変換を行う場合にtrueを指定する
+ *  @param[out] dst   変換結果の出力先バッファ
+ *  @param[in]  src   入力データの先頭を指すポインタ
+ *  @param[in]  n     入力データのサイズ (2のべき乗であること)
+ *  @param[in]  inv   逆変換を行う場合にtrueを指定する
+ *  @param[in]  pool  四段階法の並列化に用いるスレッドプール (NULLなら逐次実行)
  */
-void fft(
-	complex<double> *dst, const complex<double> *src, int n, bool inv = false)
+inline void fft(
+	complex<double> *dst, const complex<double> *src, int n, bool inv = false,
+	misc::ThreadPool *pool = NULL)
 {
+	const int FOUR_STEP_THRESHOLD = 1 << 20;
+	if(n >= FOUR_STEP_THRESHOLD){
+		if(dst == src){
+			const vector< complex<double> > copied(src, src + n);
+			FourStepFFTPlan::shared(n).transform(dst, copied.data(), inv, pool);
+		}else{
+			FourStepFFTPlan::shared(n).transform(dst, src, inv, pool);
+		}
+		return;
+	}
 	copy(src, src + n, dst);
-	for(int i = 0, j = 1; j < n - 1; ++j){
-		for(int k = n >> 1; k > (i ^= k); k >>= 1){ }
-		if(j < i){ swap(dst[i], dst[j]); }
-	}
-	double theta = (inv ? -2.0 : 2.0) * M_PI / n;
-	for(int mh = 1; (mh << 1) <= n; mh <<= 1){
-		const int m = (mh << 1);
-		int irev = 0;
-		for(int i = 0; i < n; i += m){
-			const complex<double> w = exp(complex<double>(0, theta * irev));
-			for(int k = n >> 2; k > (irev ^= k); k >>= 1){ }
-			for(int j = i; j < mh + i; ++j){
-				const int k = j + mh;
-				const complex<double> x = dst[j] - dst[k];
-				dst[j] += dst[k];
-				dst[k] = w * x;
+	FFTPlan::shared(n).transform(dst, inv);
+}
+
+/**
+ *  @brief 素朴な畳み込み
+ *
+ *  計算量は \f$ \mathcal{O}(|a||b|) \f$。
+ *
+ *  @param[in] a  1つ目の列
+ *  @param[in] b  2つ目の列
+ *  @return    a と b の畳み込み (大きさ |a|+|b|-1、どちらかが空なら空)
+ */
+template <typename T>
+vector<T> naive_convolve(const vector<T> &a, const vector<T> &b){
+	if(a.empty() || b.empty()){ return vector<T>(); }
+	vector<T> c(a.size() + b.size() - 1);
+	for(size_t i = 0; i < a.size(); ++i){
+		for(size_t j = 0; j < b.size(); ++j){ c[i + j] += a[i] * b[j]; }
+	}
+	return c;
+}
+
+/**
+ *  @brief Karatsuba法による畳み込み
+ *
+ *  長さの短い方に合わせて長い方を区切り、区間ごとに Karatsuba 法で計算する。
+ *  丸め誤差が生じないため、整数列の畳み込みを厳密に求められる。
+ *  計算量は \f$ \mathcal{O}(\max(|a|, |b|) \min(|a|, |b|)^{0.59}) \f$。
+ *
+ *  @param[in] a  1つ目の列
+ *  @param[in] b  2つ目の列
+ *  @return    a と b の畳み込み (大きさ |a|+|b|-1、どちらかが空なら空)
+ */
+template <typename T>
+vector<T> karatsuba_convolve(const vector<T> &a, const vector<T> &b){
+	struct Karatsuba {
+		// out[0, 2n) = x[0, n) * y[0, n)
+		static void multiply(const T *x, const T *y, int n, T *out, T *work){
+			if(n <= 32){
+				fill(out, out + 2 * n, T());
+				for(int i = 0; i < n; ++i){
+					for(int j = 0; j < n; ++j){ out[i + j] += x[i] * y[j]; }
+				}
+				return;
 			}
+			const int h = n / 2, k = n - h;
+			T *xs = work, *ys = work + k, *z1 = work + 2 * k;
+			multiply(x, y, h, out, work + 4 * k);
+			multiply(x + h, y + h, k, out + 2 * h, work + 4 * k);
+			for(int i = 0; i < k; ++i){
+				xs[i] = x[h + i] + (i < h ? x[i] : T());
+				ys[i] = y[h + i] + (i < h ? y[i] : T());
+			}
+			multiply(xs, ys, k, z1, work + 4 * k);
+			for(int i = 0; i < 2 * h; ++i){ z1[i] -= out[i]; }
+			for(int i = 0; i < 2 * k; ++i){ z1[i] -= out[2 * h + i]; }
+			for(int i = 0; i < 2 * k; ++i){ out[h + i] += z1[i]; }
+		}
+	};
+	if(a.empty() || b.empty()){ return vector<T>(); }
+	const vector<T> &s = (a.size() < b.size() ? a : b);
+	const vector<T> &l = (a.size() < b.size() ? b : a);
+	const int n = s.size();
+	vector<T> c(l.size() + n), chunk(n), prod(2 * n), work(8 * n + 64);
+	for(size_t i = 0; i < l.size(); i += n){
+		const size_t len = min(l.size() - i, static_cast<size_t>(n));
+		copy(l.begin() + i, l.begin() + i + len, chunk.begin());
+		fill(chunk.begin() + len, chunk.end(), T());
+		Karatsuba::multiply(chunk.data(), s.data(), n, prod.data(), work.data());
+		for(int j = 0; j < 2 * n && i + j < c.size(); ++j){ c[i + j] += prod[j]; }
+	}
+	c.resize(a.size() + b.size() - 1);
+	return c;
+}
+
+/**
+ *  @brief 高速フーリエ変換による実数列の畳み込み
+ *
+ *  実数列の変換 (FFTPlan::real_transform) を用いるため、
+ *  大きさ n/2 の複素数列の変換3回で計算する。
+ *  計算量は \f$ \mathcal{O}(n \log{n}) \f$ (n = |a|+|b|)。
+ *
+ *  @param[in] a  1つ目の列
+ *  @param[in] b  2つ目の列
+ *  @return    a と b の畳み込み (大きさ |a|+|b|-1、どちらかが空なら空)
+ */
+inline vector<double> fft_convolve(const vector<double> &a, const vector<double> &b){
+	if(a.empty() || b.empty()){ return vector<double>(); }
+	const int size = a.size() + b.size() - 1;
+	int n = 2;
+	while(n < size){ n <<= 1; }
+	const FFTPlan &plan = FFTPlan::shared(n);
+	vector<double> buffer(n);
+	vector< complex<double> > fa(n / 2 + 1), fb(n / 2 + 1);
+	copy(a.begin(), a.end(), buffer.begin());
+	plan.real_transform(buffer.data(), fa.data());
+	if(&a == &b){
+		fb = fa;
+	}else{
+		fill(buffer.begin(), buffer.end(), 0.0);
+		copy(b.begin(), b.end(), buffer.begin());
+		plan.real_transform(buffer.data(), fb.data());
+	}
+	for(int i = 0; i <= n / 2; ++i){ fa[i] *= fb[i]; }
+	plan.inverse_real_transform(fa.data(), buffer.data());
+	buffer.resize(size);
+	return buffer;
+}
+
+/**
+ *  @brief 畳み込み
+ *
+ *  短い方の列が十分に短ければ素朴な方法で、そうでなければ高速フーリエ変換で計算する。
+ *  整数型の場合、高速フーリエ変換の丸め誤差が結果に影響しうる大きさの値が
+ *  含まれていれば Karatsuba 法で厳密に計算する。
+ *
+ *  @param[in] a  1つ目の列
+ *  @param[in] b  2つ目の列
+ *  @return    a と b の畳み込み (大きさ |a|+|b|-1、どちらかが空なら空)
+ */
+template <typename T>
+vector<T> convolve(const vector<T> &a, const vector<T> &b){
+	const size_t NAIVE_LIMIT = 48;
+	if(min(a.size(), b.size()) <= NAIVE_LIMIT){ return naive_convolve(a, b); }
+	if(is_integral<T>::value){
+		// 二乗和と変換長の対数の積が 9e14 未満なら最近接整数への丸めで正しい値が得られる
+		double norm = 0.0;
+		for(size_t i = 0; i < a.size(); ++i){ norm += static_cast<double>(a[i]) * a[i]; }
+		for(size_t i = 0; i < b.size(); ++i){ norm += static_cast<double>(b[i]) * b[i]; }
+		if(norm * log2(static_cast<double>(a.size() + b.size())) >= 9e14){
+			return karatsuba_convolve(a, b);
 		}
 	}
-	if(inv){
-		const double r = 1.0 / n;
-		for(int i = 0; i < n; ++i){ dst[i] *= r; }
+	const vector<double> c = fft_convolve(
+		vector<double>(a.begin(), a.end()), vector<double>(b.begin(), b.end()));
+	vector<T> result(c.size());
+	for(size_t i = 0; i < c.size(); ++i){
+		if(is_integral<T>::value){
+			result[i] = static_cast<T>(llround(c[i]));
+		}else{
+			result[i] = static_cast<T>(c[i]);
+		}
 	}
+	return result;
 }
 
 /**
@@ -61,4 +532,3 @@ void fft(
 
 }
 }
-
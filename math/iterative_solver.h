@@ -0,0 +1,278 @@
+/**
+ *  @file math/iterative_solver.h
+ */
+#pragma once
+#include <vector>
+#include <cmath>
+#include <cassert>
+#include "common/header.h"
+#include "math/sparse_matrix.h"
+#include "misc/thread_pool.h"
+
+namespace libcomp {
+namespace math {
+
+/**
+ *  @defgroup iterative_solver Iterative solver
+ *  @ingroup  math
+ *  @{
+ */
+
+/**
+ *  @brief 反復解法に共通するベクトル演算
+ */
+class IterativeSolverBase {
+
+protected:
+	static double dot(const vector<double> &a, const vector<double> &b){
+		double sum = 0.0;
+		for(size_t i = 0; i < a.size(); ++i){ sum += a[i] * b[i]; }
+		return sum;
+	}
+
+	static double norm(const vector<double> &a){ return sqrt(dot(a, a)); }
+
+	// r = b - Ax
+	static void residual(
+		const SparseMatrix<double> &a, const vector<double> &b,
+		const vector<double> &x, vector<double> &r, misc::ThreadPool *pool)
+	{
+		a.multiply(x, r, pool);
+		for(size_t i = 0; i < r.size(); ++i){ r[i] = b[i] - r[i]; }
+	}
+
+};
+
+/**
+ *  @brief 共役勾配法
+ *
+ *  対称正定値行列を係数とする連立1次方程式 \f$ Ax = b \f$ を解く。
+ *  作業用のベクトルは構築時に確保し、solve の呼び出し間で再利用する。
+ *  1反復あたりの計算量は \f$ \mathcal{O}(n + \mathit{nnz}) \f$。
+ */
+class ConjugateGradient : public IterativeSolverBase {
+
+private:
+	vector<double> m_r, m_p, m_q;
+
+public:
+	/**
+	 *  @brief コンストラクタ
+	 *  @param[in] n  方程式の大きさ
+	 */
+	explicit ConjugateGradient(int n) : m_r(n), m_p(n), m_q(n) { }
+
+	/**
+	 *  @brief 連立1次方程式の求解
+	 *
+	 *  残差のノルムが \f$ \mathit{tolerance} \cdot \|b\| \f$ 以下になるまで反復する。
+	 *
+	 *  @param[in]     a               係数行列 (対称正定値)
+	 *  @param[in]     b               右辺値
+	 *  @param[in,out] x               初期解。終了時には近似解が格納される。
+	 *  @param[in]     tolerance       相対残差の許容値
+	 *  @param[in]     max_iterations  最大反復回数
+	 *  @param[in]     pool            並列化に用いるスレッドプール (NULLなら逐次実行)
+	 *  @return        収束までの反復回数。収束しなかった場合は -1。
+	 */
+	int solve(
+		const SparseMatrix<double> &a, const vector<double> &b, vector<double> &x,
+		double tolerance = 1e-10, int max_iterations = 10000,
+		misc::ThreadPool *pool = NULL)
+	{
+		assert(a.rows() == a.columns() && a.rows() == static_cast<int>(m_r.size()));
+		const int n = m_r.size();
+		x.resize(n);
+		const double threshold = tolerance * norm(b);
+		residual(a, b, x, m_r, pool);
+		m_p = m_r;
+		double rr = dot(m_r, m_r);
+		if(sqrt(rr) <= threshold){ return 0; }
+		for(int it = 1; it <= max_iterations; ++it){
+			a.multiply(m_p, m_q, pool);
+			const double pq = dot(m_p, m_q);
+			if(pq == 0.0){ return -1; }
+			const double alpha = rr / pq;
+			for(int i = 0; i < n; ++i){
+				x[i] += alpha * m_p[i];
+				m_r[i] -= alpha * m_q[i];
+			}
+			const double rr_next = dot(m_r, m_r);
+			if(sqrt(rr_next) <= threshold){ return it; }
+			const double beta = rr_next / rr;
+			for(int i = 0; i < n; ++i){ m_p[i] = m_r[i] + beta * m_p[i]; }
+			rr = rr_next;
+		}
+		return -1;
+	}
+
+};
+
+/**
+ *  @brief 安定化双共役勾配法 (BiCGSTAB)
+ *
+ *  一般の正則行列を係数とする連立1次方程式 \f$ Ax = b \f$ を解く。
+ *  作業用のベクトルは構築時に確保し、solve の呼び出し間で再利用する。
+ *  1反復あたりの計算量は \f$ \mathcal{O}(n + \mathit{nnz}) \f$。
+ */
+class BiCGSTAB : public IterativeSolverBase {
+
+private:
+	vector<double> m_r, m_r0, m_p, m_v, m_s, m_t;
+
+public:
+	/**
+	 *  @brief コンストラクタ
+	 *  @param[in] n  方程式の大きさ
+	 */
+	explicit BiCGSTAB(int n) :
+		m_r(n), m_r0(n), m_p(n), m_v(n), m_s(n), m_t(n)
+	{ }
+
+	/**
+	 *  @brief 連立1次方程式の求解
+	 *
+	 *  残差のノルムが \f$ \mathit{tolerance} \cdot \|b\| \f$ 以下になるまで反復する。
+	 *
+	 *  @param[in]     a               係数行列
+	 *  @param[in]     b               右辺値
+	 *  @param[in,out] x               初期解。終了時には近似解が格納される。
+	 *  @param[in]     tolerance       相対残差の許容値
+	 *  @param[in]     max_iterations  最大反復回数
+	 *  @param[in]     pool            並列化に用いるスレッドプール (NULLなら逐次実行)
+	 *  @return        収束までの反復回数。収束しなかった場合や破綻した場合は -1。
+	 */
+	int solve(
+		const SparseMatrix<double> &a, const vector<double> &b, vector<double> &x,
+		double tolerance = 1e-10, int max_iterations = 10000,
+		misc::ThreadPool *pool = NULL)
+	{
+		assert(a.rows() == a.columns() && a.rows() == static_cast<int>(m_r.size()));
+		const int n = m_r.size();
+		x.resize(n);
+		const double threshold = tolerance * norm(b);
+		residual(a, b, x, m_r, pool);
+		if(norm(m_r) <= threshold){ return 0; }
+		m_r0 = m_r;
+		fill(m_p.begin(), m_p.end(), 0.0);
+		fill(m_v.begin(), m_v.end(), 0.0);
+		double rho = 1.0, alpha = 1.0, omega = 1.0;
+		for(int it = 1; it <= max_iterations; ++it){
+			const double rho_next = dot(m_r0, m_r);
+			if(rho_next == 0.0 || omega == 0.0){ return -1; }
+			const double beta = (rho_next / rho) * (alpha / omega);
+			for(int i = 0; i < n; ++i){
+				m_p[i] = m_r[i] + beta * (m_p[i] - omega * m_v[i]);
+			}
+			a.multiply(m_p, m_v, pool);
+			const double r0v = dot(m_r0, m_v);
+			if(r0v == 0.0){ return -1; }
+			alpha = rho_next / r0v;
+			for(int i = 0; i < n; ++i){ m_s[i] = m_r[i] - alpha * m_v[i]; }
+			if(norm(m_s) <= threshold){
+				for(int i = 0; i < n; ++i){ x[i] += alpha * m_p[i]; }
+				return it;
+			}
+			a.multiply(m_s, m_t, pool);
+			const double tt = dot(m_t, m_t);
+			omega = (tt == 0.0 ? 0.0 : dot(m_t, m_s) / tt);
+			for(int i = 0; i < n; ++i){
+				x[i] += alpha * m_p[i] + omega * m_s[i];
+				m_r[i] = m_s[i] - omega * m_t[i];
+			}
+			if(norm(m_r) <= threshold){ return it; }
+			rho = rho_next;
+		}
+		return -1;
+	}
+
+};
+
+/**
+ *  @brief べき乗法
+ *
+ *  行列 A (または \f$ A^{\mathrm{T}} \f$) の絶対値最大の固有値と
+ *  その固有ベクトルを求める。
+ *  固有ベクトルはユークリッドノルムが1になるように正規化される。
+ *  マルコフ連鎖の定常分布を求める場合は、遷移行列に対して transposed を指定し、
+ *  得られたベクトルを総和が1になるように正規化すればよい。
+ *  作業用のベクトルは構築時に確保し、solve の呼び出し間で再利用する。
+ *  1反復あたりの計算量は \f$ \mathcal{O}(n + \mathit{nnz}) \f$。
+ */
+class PowerIteration : public IterativeSolverBase {
+
+private:
+	vector<double> m_y;
+	double m_eigenvalue;
+
+public:
+	/**
+	 *  @brief コンストラクタ
+	 *  @param[in] n  行列の大きさ
+	 */
+	explicit PowerIteration(int n) : m_y(n), m_eigenvalue(0.0) { }
+
+	/**
+	 *  @brief 固有値の取得
+	 *  @return 直前の solve で得られた固有値の推定値
+	 */
+	double eigenvalue() const { return m_eigenvalue; }
+
+	/**
+	 *  @brief 固有ベクトルの計算
+	 *
+	 *  連続する反復の間でのベクトルの変化量が tolerance 以下になるまで反復する。
+	 *
+	 *  @param[in]     a               対象の行列 (正方行列)
+	 *  @param[in,out] x               初期ベクトル (零ベクトルの場合はすべて1から始める)。
+	 *                                 終了時には固有ベクトルの近似が格納される。
+	 *  @param[in]     tolerance       変化量の許容値
+	 *  @param[in]     max_iterations  最大反復回数
+	 *  @param[in]     pool            並列化に用いるスレッドプール (NULLなら逐次実行)
+	 *  @param[in]     transposed      真なら \f$ A^{\mathrm{T}} \f$ に対して計算する
+	 *  @return        収束までの反復回数。収束しなかった場合は -1。
+	 */
+	int solve(
+		const SparseMatrix<double> &a, vector<double> &x,
+		double tolerance = 1e-10, int max_iterations = 10000,
+		misc::ThreadPool *pool = NULL, bool transposed = false)
+	{
+		assert(a.rows() == a.columns() && a.rows() == static_cast<int>(m_y.size()));
+		const int n = m_y.size();
+		x.resize(n);
+		double x_norm = norm(x);
+		if(x_norm == 0.0){
+			fill(x.begin(), x.end(), 1.0);
+			x_norm = norm(x);
+		}
+		for(int i = 0; i < n; ++i){ x[i] /= x_norm; }
+		for(int it = 1; it <= max_iterations; ++it){
+			if(transposed){
+				a.multiply_transposed(x, m_y, pool);
+			}else{
+				a.multiply(x, m_y, pool);
+			}
+			m_eigenvalue = dot(x, m_y);
+			const double y_norm = norm(m_y);
+			if(y_norm == 0.0){ return it; }
+			// 固有値が負のときは反復ごとに符号が反転するので、向きを揃えてから比較する
+			const double scale = (m_eigenvalue < 0.0 ? -1.0 : 1.0) / y_norm;
+			double diff = 0.0;
+			for(int i = 0; i < n; ++i){
+				m_y[i] *= scale;
+				diff += (m_y[i] - x[i]) * (m_y[i] - x[i]);
+			}
+			x.swap(m_y);
+			if(sqrt(diff) <= tolerance){ return it; }
+		}
+		return -1;
+	}
+
+};
+
+/**
+ *  @}
+ */
+
+}
+}
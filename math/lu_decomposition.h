@@ -0,0 +1,331 @@
+/**
+ *  @file math/lu_decomposition.h
+ */
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cassert>
+#include "common/header.h"
+#include "math/matrix.h"
+
+namespace libcomp {
+namespace math {
+
+/**
+ *  @defgroup lu_decomposition LU decomposition
+ *  @ingroup  math
+ *  @{
+ */
+
+/**
+ *  @brief 部分ピボット選択付きLU分解
+ *
+ *  正方行列 A を \f$ PA = LU \f$ の形に一度だけ分解し、
+ *  同じ係数行列を持つ連立1次方程式を右辺ごとに \f$ \mathcal{O}(n^2) \f$ で解く。
+ *  L (対角成分は1) と U は1本の連続した配列に行優先でまとめて格納する。
+ *  分解は幅 BLOCK のパネルごとに行い、残りの部分行列の更新は
+ *  キャッシュブロッキングした行列積として計算する (right-looking)。
+ */
+class LUDecomposition {
+
+private:
+	int n;
+	vector<double> lu;
+	vector<int> perm;
+	int sign;
+	bool singular;
+
+	double *row(int i){ return &lu[i * n]; }
+	const double *row(int i) const { return &lu[i * n]; }
+
+	void swap_rows(int a, int b){
+		if(a == b){ return; }
+		swap_ranges(lu.begin() + a * n, lu.begin() + (a + 1) * n, lu.begin() + b * n);
+		swap(perm[a], perm[b]);
+		sign = -sign;
+	}
+
+	/*
+	 *  [k0, k1) 列のパネルを分解する。
+	 *  ピボット選択による行の交換は行全体に対して行う。
+	 */
+	void factor_panel(int k0, int k1){
+		for(int c = k0; c < k1; ++c){
+			int pivot = c;
+			for(int r = c + 1; r < n; ++r){
+				if(fabs(row(r)[c]) > fabs(row(pivot)[c])){ pivot = r; }
+			}
+			swap_rows(pivot, c);
+			const double *pc = row(c);
+			if(pc[c] == 0.0){
+				singular = true;
+				continue;
+			}
+			const double inv = 1.0 / pc[c];
+			for(int r = c + 1; r < n; ++r){
+				double *pr = row(r);
+				const double l = (pr[c] *= inv);
+				if(l == 0.0){ continue; }
+				for(int j = c + 1; j < k1; ++j){ pr[j] -= l * pc[j]; }
+			}
+		}
+	}
+
+	/*
+	 *  C -= AB を計算する。A は rows x depth、B は depth x cols 行列で、
+	 *  各行列は先頭要素へのポインタと行の間隔で与える。
+	 *  depth 方向を BLOCK_K ずつに分け、B の BLOCK_K x BLOCK_J の部分を
+	 *  キャッシュに載せたまま C の全行を処理する。
+	 *  C の4行4列はレジスタ上に保持したまま積和を取る。
+	 */
+	static void subtract_product(
+		const double *a, int lda, const double *b, int ldb,
+		double *c, int ldc, int rows, int cols, int depth)
+	{
+		const int BLOCK_K = 128;
+		for(int kk = 0; kk < depth; kk += BLOCK_K){
+			subtract_product_panel(
+				a + kk, lda, b + kk * ldb, ldb, c, ldc, rows, cols, min(BLOCK_K, depth - kk));
+		}
+	}
+
+	static void subtract_product_panel(
+		const double *a, int lda, const double *b, int ldb,
+		double *c, int ldc, int rows, int cols, int depth)
+	{
+		const int BLOCK_J = 256, TILE_I = 4, TILE_J = 4;
+		for(int jj = 0; jj < cols; jj += BLOCK_J){
+			const int j1 = min(jj + BLOCK_J, cols);
+			int i = 0;
+			for(; i + TILE_I <= rows; i += TILE_I){
+				const double *a0 = a + i * lda, *a1 = a0 + lda, *a2 = a1 + lda, *a3 = a2 + lda;
+				double *c0 = c + i * ldc, *c1 = c0 + ldc, *c2 = c1 + ldc, *c3 = c2 + ldc;
+				int j = jj;
+				for(; j + TILE_J <= j1; j += TILE_J){
+					double x00 = c0[j], x01 = c0[j + 1], x02 = c0[j + 2], x03 = c0[j + 3];
+					double x10 = c1[j], x11 = c1[j + 1], x12 = c1[j + 2], x13 = c1[j + 3];
+					double x20 = c2[j], x21 = c2[j + 1], x22 = c2[j + 2], x23 = c2[j + 3];
+					double x30 = c3[j], x31 = c3[j + 1], x32 = c3[j + 2], x33 = c3[j + 3];
+					const double *bk = b + j;
+					for(int k = 0; k < depth; ++k, bk += ldb){
+						const double b0 = bk[0], b1 = bk[1], b2 = bk[2], b3 = bk[3];
+						const double y0 = a0[k], y1 = a1[k], y2 = a2[k], y3 = a3[k];
+						x00 -= y0 * b0; x01 -= y0 * b1; x02 -= y0 * b2; x03 -= y0 * b3;
+						x10 -= y1 * b0; x11 -= y1 * b1; x12 -= y1 * b2; x13 -= y1 * b3;
+						x20 -= y2 * b0; x21 -= y2 * b1; x22 -= y2 * b2; x23 -= y2 * b3;
+						x30 -= y3 * b0; x31 -= y3 * b1; x32 -= y3 * b2; x33 -= y3 * b3;
+					}
+					c0[j] = x00; c0[j + 1] = x01; c0[j + 2] = x02; c0[j + 3] = x03;
+					c1[j] = x10; c1[j + 1] = x11; c1[j + 2] = x12; c1[j + 3] = x13;
+					c2[j] = x20; c2[j + 1] = x21; c2[j + 2] = x22; c2[j + 3] = x23;
+					c3[j] = x30; c3[j + 1] = x31; c3[j + 2] = x32; c3[j + 3] = x33;
+				}
+				const double *ai = a0;
+				double *ci = c0;
+				for(int r = 0; r < TILE_I; ++r){
+					for(int k = 0; k < depth; ++k){
+						const double x = ai[r * lda + k];
+						const double *bk = b + k * ldb;
+						for(int q = j; q < j1; ++q){ ci[r * ldc + q] -= x * bk[q]; }
+					}
+				}
+			}
+			for(; i < rows; ++i){
+				const double *ai = a + i * lda;
+				double *ci = c + i * ldc;
+				for(int k = 0; k < depth; ++k){
+					const double x = ai[k];
+					const double *bk = b + k * ldb;
+					for(int q = jj; q < j1; ++q){ ci[q] -= x * bk[q]; }
+				}
+			}
+		}
+	}
+
+	/*
+	 *  U12 = L11^{-1} A12 を求めたあと、A22 -= L21 U12 で残りを更新する。
+	 */
+	void update_trailing(int k0, int k1){
+		for(int i = k0; i < k1; ++i){
+			double *pi = row(i);
+			for(int k = k0; k < i; ++k){
+				const double l = pi[k];
+				const double *pk = row(k);
+				for(int j = k1; j < n; ++j){ pi[j] -= l * pk[j]; }
+			}
+		}
+		if(k1 == n){ return; }
+		subtract_product(
+			&lu[k1 * n + k0], n, &lu[k0 * n + k1], n, &lu[k1 * n + k1], n,
+			n - k1, n - k1, k1 - k0);
+	}
+
+	void factorize(){
+		const int BLOCK = 64;
+		for(int i = 0; i < n; ++i){ perm[i] = i; }
+		for(int k0 = 0; k0 < n; k0 += BLOCK){
+			const int k1 = min(k0 + BLOCK, n);
+			factor_panel(k0, k1);
+			update_trailing(k0, k1);
+		}
+	}
+
+public:
+	/**
+	 *  @brief コンストラクタ
+	 *
+	 *  係数行列をLU分解する。計算量は \f$ \mathcal{O}(n^3) \f$。
+	 *
+	 *  @param[in] a  係数行列 (正方行列)
+	 */
+	explicit LUDecomposition(const Matrix<double> &a) :
+		n(a.rows()), lu(n * n), perm(n), sign(1), singular(false)
+	{
+		assert(a.rows() == a.columns());
+		for(int i = 0; i < n; ++i){
+			for(int j = 0; j < n; ++j){ lu[i * n + j] = a(i, j); }
+		}
+		factorize();
+	}
+
+	/**
+	 *  @brief コンストラクタ
+	 *
+	 *  係数行列をLU分解する。計算量は \f$ \mathcal{O}(n^3) \f$。
+	 *
+	 *  @param[in] a  係数行列 (正方行列)
+	 */
+	explicit LUDecomposition(const vector< vector<double> > &a) :
+		n(a.size()), lu(n * n), perm(n), sign(1), singular(false)
+	{
+		for(int i = 0; i < n; ++i){
+			assert(static_cast<int>(a[i].size()) == n);
+			copy(a[i].begin(), a[i].end(), lu.begin() + i * n);
+		}
+		factorize();
+	}
+
+	/**
+	 *  @brief 行列の大きさの取得
+	 *  @return 係数行列の行数
+	 */
+	int size() const { return n; }
+
+	/**
+	 *  @brief 特異性の判定
+	 *  @retval true   係数行列が特異である (ピボットが0になった)
+	 *  @retval false  係数行列が正則である
+	 */
+	bool is_singular() const { return singular; }
+
+	/**
+	 *  @brief 行列式
+	 *
+	 *  計算量は \f$ \mathcal{O}(n) \f$。
+	 *
+	 *  @return 係数行列の行列式
+	 */
+	double determinant() const {
+		if(singular){ return 0.0; }
+		double det = sign;
+		for(int i = 0; i < n; ++i){ det *= row(i)[i]; }
+		return det;
+	}
+
+	/**
+	 *  @brief 連立1次方程式の求解
+	 *
+	 *  \f$ Ax = b \f$ の解を前進代入と後退代入で求める。
+	 *  計算量は \f$ \mathcal{O}(n^2) \f$。
+	 *
+	 *  @param[in] b  右辺値
+	 *  @return    方程式の解。係数行列が特異な場合は空のベクタを返す。
+	 */
+	vector<double> solve(const vector<double> &b) const {
+		assert(static_cast<int>(b.size()) == n);
+		if(singular){ return vector<double>(); }
+		vector<double> x(n);
+		for(int i = 0; i < n; ++i){
+			const double *pi = row(i);
+			double s = b[perm[i]];
+			for(int k = 0; k < i; ++k){ s -= pi[k] * x[k]; }
+			x[i] = s;
+		}
+		for(int i = n - 1; i >= 0; --i){
+			const double *pi = row(i);
+			double s = x[i];
+			for(int k = i + 1; k < n; ++k){ s -= pi[k] * x[k]; }
+			x[i] = s / pi[i];
+		}
+		return x;
+	}
+
+	/**
+	 *  @brief 複数の右辺に対する連立1次方程式の求解
+	 *
+	 *  \f$ AX = B \f$ の解を求める。
+	 *  前進代入と後退代入を BLOCK 行ずつ進め、
+	 *  既に求まった行からの寄与を行列積としてまとめて差し引く。
+	 *  計算量は \f$ \mathcal{O}(n^2 k) \f$ (kは右辺の数)。
+	 *
+	 *  @param[in] b  右辺値を列として並べた n x k 行列
+	 *  @return    解を列として並べた n x k 行列。
+	 *             係数行列が特異な場合は 0x0 の行列を返す。
+	 */
+	Matrix<double> solve_many(const Matrix<double> &b) const {
+		assert(b.rows() == n);
+		if(singular){ return Matrix<double>(0, 0); }
+		const int m = b.columns();
+		if(m == 0){ return Matrix<double>(n, 0); }
+		const int BLOCK = 64;
+		vector<double> x(n * m);
+		for(int i = 0; i < n; ++i){
+			for(int j = 0; j < m; ++j){ x[i * m + j] = b(perm[i], j); }
+		}
+		for(int i0 = 0; i0 < n; i0 += BLOCK){
+			const int i1 = min(i0 + BLOCK, n);
+			subtract_product(row(i0), n, &x[0], m, &x[i0 * m], m, i1 - i0, m, i0);
+			for(int i = i0; i < i1; ++i){
+				const double *pi = row(i);
+				double *xi = &x[i * m];
+				for(int k = i0; k < i; ++k){
+					const double l = pi[k];
+					const double *xk = &x[k * m];
+					for(int j = 0; j < m; ++j){ xi[j] -= l * xk[j]; }
+				}
+			}
+		}
+		for(int i1 = n; i1 > 0; i1 -= BLOCK){
+			const int i0 = max(i1 - BLOCK, 0);
+			if(i1 < n){
+				subtract_product(
+					row(i0) + i1, n, &x[i1 * m], m, &x[i0 * m], m, i1 - i0, m, n - i1);
+			}
+			for(int i = i1 - 1; i >= i0; --i){
+				const double *pi = row(i);
+				double *xi = &x[i * m];
+				for(int k = i + 1; k < i1; ++k){
+					const double u = pi[k];
+					const double *xk = &x[k * m];
+					for(int j = 0; j < m; ++j){ xi[j] -= u * xk[j]; }
+				}
+				const double inv = 1.0 / pi[i];
+				for(int j = 0; j < m; ++j){ xi[j] *= inv; }
+			}
+		}
+		Matrix<double> ret(n, m);
+		for(int i = 0; i < n; ++i){
+			for(int j = 0; j < m; ++j){ ret(i, j) = x[i * m + j]; }
+		}
+		return ret;
+	}
+
+};
+
+/**
+ *  @}
+ */
+
+}
+}
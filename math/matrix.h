@@ -8,6 +8,8 @@
 #include <functional>
 #include <cassert>
 #include "common/header.h"
+#include "misc/thread_pool.h"
+#include "math/matrix_expression.h"
 
 namespace libcomp {
 namespace math {
@@ -22,36 +24,67 @@ namespace math {
  *  @brief 可変サイズ行列
  *
  *  実行時にサイズ設定可能な行列型。
+ *  要素は行優先で1本の連続した配列に格納される。
+ *  要素ごとの演算は MatrixExpression による式として遅延評価され、
+ *  代入時に一時行列を作らずに1つのループで計算される。
  *
  *  @tparam T  要素の表現に用いる型
  */
 template <typename T>
-class Matrix {
+class Matrix : public MatrixExpression< Matrix<T> > {
+
+public:
+	/// 要素の型
+	typedef T value_type;
 
 private:
 	int N, M;
-	vector< vector<T> > data;
-
-	template <typename _Func>
-	Matrix<T> apply(_Func f) const {
-		Matrix<T> ret(N, M);
-		for(int i = 0; i < N; ++i){
-			for(int j = 0; j < M; ++j){ ret(i, j) = f(data[i][j]); }
-		}
-		return ret;
-	}
-
-	template <typename _Func>
-	Matrix<T> apply_scalar(const T &s, _Func f) const { return apply(bind2nd(f, s)); }
+	vector<T> data;
 
-	template <typename _Func>
-	Matrix<T> apply_mat(const Matrix<T> &m, _Func f) const {
-		assert(N == m.N && M == m.M);
-		Matrix<T> ret(N, M);
-		for(int i = 0; i < N; ++i){
-			for(int j = 0; j < M; ++j){ ret(i, j) = f(data[i][j], m(i, j)); }
+	/*
+	 *  c の [i0, i1) 行目に a * b を加算する。
+	 *  b のパネル (BLOCK_K x BLOCK_J) をキャッシュに載せたまま、
+	 *  c の4行ずつに対して i-k-j 順で更新する。
+	 *  最内ループは連続領域に対する積和なので自動ベクトル化の対象となる。
+	 */
+	static void multiply_add(
+		const Matrix<T> &a, const Matrix<T> &b, Matrix<T> &c, int i0, int i1)
+	{
+		const int BLOCK_K = 128, BLOCK_J = 256, TILE_I = 4;
+		const int K = a.M, L = b.M;
+		for(int kk = 0; kk < K; kk += BLOCK_K){
+			const int k1 = min(kk + BLOCK_K, K);
+			for(int jj = 0; jj < L; jj += BLOCK_J){
+				const int j1 = min(jj + BLOCK_J, L);
+				int i = i0;
+				for(; i + TILE_I <= i1; i += TILE_I){
+					T *c0 = &c.data[(i + 0) * L], *c1 = &c.data[(i + 1) * L];
+					T *c2 = &c.data[(i + 2) * L], *c3 = &c.data[(i + 3) * L];
+					for(int k = kk; k < k1; ++k){
+						const T *bk = &b.data[k * L];
+						const T a0 = a.data[(i + 0) * K + k];
+						const T a1 = a.data[(i + 1) * K + k];
+						const T a2 = a.data[(i + 2) * K + k];
+						const T a3 = a.data[(i + 3) * K + k];
+						for(int j = jj; j < j1; ++j){
+							const T x = bk[j];
+							c0[j] += a0 * x;
+							c1[j] += a1 * x;
+							c2[j] += a2 * x;
+							c3[j] += a3 * x;
+						}
+					}
+				}
+				for(; i < i1; ++i){
+					T *ci = &c.data[i * L];
+					for(int k = kk; k < k1; ++k){
+						const T *bk = &b.data[k * L];
+						const T aik = a.data[i * K + k];
+						for(int j = jj; j < j1; ++j){ ci[j] += aik * bk[j]; }
+					}
+				}
+			}
 		}
-		return ret;
 	}
 
 public:
@@ -60,7 +93,7 @@ public:
 	 *  @param[in] N  行列の行数
 	 *  @param[in] M  行列の列数
 	 */
-	Matrix(int N, int M) : N(N), M(M), data(N, vector<T>(M)) { }
+	Matrix(int N, int M) : N(N), M(M), data(N * M) { }
 
 	/**
 	 *  @brief 行列の行数の取得
@@ -79,133 +112,213 @@ public:
 	 *  @param[in] j  取得したい要素の列番号
 	 *  @return    指定したインデックスに対応する要素への参照
 	 */
-	const T &operator()(int i, int j) const { return data[i][j]; }
+	const T &operator()(int i, int j) const { return data[i * M + j]; }
 	/**
 	 *  @brief 行列内の要素の取得
 	 *  @param[in] i  取得したい要素の行番号
 	 *  @param[in] j  取得したい要素の列番号
 	 *  @return    指定したインデックスに対応する要素への参照
 	 */
-	T &operator()(int i, int j){ return data[i][j]; }
+	T &operator()(int i, int j){ return data[i * M + j]; }
 
 	/**
-	 *  @brief 行列の符号を反転
-	 *  @return すべての要素の正負が入れ替えられた行列
+	 *  @brief 式からの構築
+	 *
+	 *  要素ごとの演算を表す式を1回のループで評価して行列を構築する。
+	 *
+	 *  @param[in] e  評価する式
 	 */
-	Matrix<T> operator-() const { return apply(negate<T>()); }
+	template <typename E>
+	Matrix(const MatrixExpression<E> &e) :
+		N(e.self().rows()), M(e.self().columns()), data(N * M)
+	{
+		const E &x = e.self();
+		for(int k = 0; k < N * M; ++k){ data[k] = x.eval(k); }
+	}
 
 	/**
-	 *  @brief 行列とスカラの加算
-	 *  @param[in] s  加算するスカラ
-	 *  @return    すべての要素にsを加算した行列
+	 *  @brief 式の代入
+	 *
+	 *  要素ごとの演算を表す式を1回のループで評価して代入する。
+	 *  各要素は同じ位置の要素のみから計算されるため、
+	 *  右辺に自身が含まれていてもよい。
+	 *
+	 *  @param[in] e  評価する式
+	 *  @return    自身への参照
 	 */
-	Matrix<T> operator+(const T &s) const { return apply_scalar(s, plus<T>()); }
+	template <typename E>
+	Matrix<T> &operator=(const MatrixExpression<E> &e){
+		const E &x = e.self();
+		if(N != x.rows() || M != x.columns()){
+			N = x.rows();
+			M = x.columns();
+			data.resize(N * M);
+		}
+		for(int k = 0; k < N * M; ++k){ data[k] = x.eval(k); }
+		return *this;
+	}
+
 	/**
-	 *  @brief 行列とスカラの加算 + 代入
-	 *  @param[in] s  加算するスカラ
-	 *  @return    自身への参照
+	 *  @brief 通し番号による要素の取得
+	 *  @param[in] k  行優先で数えた要素の通し番号
+	 *  @return    k番目の要素
 	 */
-	Matrix<T> &operator+=(const T &s){ return *this = *this + s; }
+	const T &eval(int k) const { return data[k]; }
 
 	/**
-	 *  @brief 行列とスカラの減算
-	 *  @param[in] s  減算するスカラ
-	 *  @return    すべての要素にsを減算した行列
+	 *  @brief 行列とスカラの加算 + 代入
+	 *  @param[in] s  加算するスカラ
+	 *  @return    自身への参照
 	 */
-	Matrix<T> operator-(const T &s) const { return apply_scalar(s, minus<T>()); }
+	Matrix<T> &operator+=(const T &s){
+		for(int k = 0; k < N * M; ++k){ data[k] += s; }
+		return *this;
+	}
 	/**
 	 *  @brief 行列とスカラの減算 + 代入
 	 *  @param[in] s  減算するスカラ
 	 *  @return    自身への参照
 	 */
-	Matrix<T> &operator-=(const T &s){ return *this = *this - s; }
-
-	/**
-	 *  @brief 行列とスカラの乗算
-	 *  @param[in] s  乗算するスカラ
-	 *  @return    すべての要素にsを乗算した行列
-	 */
-	Matrix<T> operator*(const T &s) const { return apply_scalar(s, multiplies<T>()); }
+	Matrix<T> &operator-=(const T &s){
+		for(int k = 0; k < N * M; ++k){ data[k] -= s; }
+		return *this;
+	}
 	/**
 	 *  @brief 行列とスカラの乗算 + 代入
 	 *  @param[in] s  乗算するスカラ
 	 *  @return    自身への参照
 	 */
-	Matrix<T> &operator*=(const T &s){ return *this = *this * s; }
-
-	/**
-	 *  @brief 行列とスカラの除算
-	 *  @param[in] s  除算するスカラ
-	 *  @return    すべての要素にsを除算した行列
-	 */
-	Matrix<T> operator/(const T &s) const { return apply_scalar(s, divides<T>()); }
+	Matrix<T> &operator*=(const T &s){
+		for(int k = 0; k < N * M; ++k){ data[k] *= s; }
+		return *this;
+	}
 	/**
 	 *  @brief 行列とスカラの除算 + 代入
 	 *  @param[in] s  除算するスカラ
 	 *  @return    自身への参照
 	 */
-	Matrix<T> &operator/=(const T &s){ return *this = *this / s; }
-
-	/**
-	 *  @brief 行列とスカラの剰余
-	 *  @param[in] s  剰余を取るスカラ
-	 *  @return    すべての要素にsとの剰余をとった行列
-	 */
-	Matrix<T> operator%(const T &s) const { return apply_scalar(s, modulus<T>()); }
+	Matrix<T> &operator/=(const T &s){
+		for(int k = 0; k < N * M; ++k){ data[k] /= s; }
+		return *this;
+	}
 	/**
 	 *  @brief 行列とスカラの剰余 + 代入
 	 *  @param[in] s  剰余を取るスカラ
 	 *  @return    自身への参照
 	 */
-	Matrix<T> &operator%=(const T &s){ return *this = *this % s; }
+	Matrix<T> &operator%=(const T &s){
+		for(int k = 0; k < N * M; ++k){ data[k] %= s; }
+		return *this;
+	}
 
 	/**
-	 *  @brief 行列と行列の加算
-	 *  @param[in] m  加算する行列
-	 *  @return    (*this)とmの和
-	 */
-	Matrix<T> operator+(const Matrix<T> &m) const { return apply_mat(m, plus<T>()); }
-	/**
-	 *  @brief 行列と行列の加算 + 代入
-	 *  @param[in] m  加算する行列
+	 *  @brief 行列と式の加算 + 代入
+	 *  @param[in] e  加算する行列または式
 	 *  @return    自身への参照
 	 */
-	Matrix<T> &operator+=(const Matrix<T> &m){ return *this = *this + m; }
-
-	/**
-	 *  @brief 行列と行列の減算
-	 *  @param[in] m  減算する行列
-	 *  @return    (*this)とmの差
-	 */
-	Matrix<T> operator-(const Matrix<T> &m) const { return apply_mat(m, minus<T>()); }
+	template <typename E>
+	Matrix<T> &operator+=(const MatrixExpression<E> &e){
+		const E &x = e.self();
+		assert(N == x.rows() && M == x.columns());
+		for(int k = 0; k < N * M; ++k){ data[k] += x.eval(k); }
+		return *this;
+	}
 	/**
-	 *  @brief 行列と行列の減算 + 代入
-	 *  @param[in] m  減算する行列
+	 *  @brief 行列と式の減算 + 代入
+	 *  @param[in] e  減算する行列または式
 	 *  @return    自身への参照
 	 */
-	Matrix<T> &operator-=(const Matrix<T> &m){ return *this = *this - m; }
+	template <typename E>
+	Matrix<T> &operator-=(const MatrixExpression<E> &e){
+		const E &x = e.self();
+		assert(N == x.rows() && M == x.columns());
+		for(int k = 0; k < N * M; ++k){ data[k] -= x.eval(k); }
+		return *this;
+	}
 
 	/**
 	 *  @brief 行列と行列の乗算
+	 *
+	 *  キャッシュブロッキングとレジスタタイリングを行ったi-k-j順の積。
+	 *  計算量は \f$ \mathcal{O}(NML) \f$。
+	 *
 	 *  @param[in] m  乗算する行列
 	 *  @return    (*this)とmの積
 	 */
 	Matrix<T> operator*(const Matrix<T> &m) const {
 		assert(M == m.N);
 		Matrix<T> ret(N, m.M);
-		for(int i = 0; i < N; ++i){
-			for(int j = 0; j < m.M; ++j){
-				for(int k = 0; k < M; ++k){ ret(i, j) += data[i][k] * m(k, j); }
-			}
+		multiply_add(*this, m, ret, 0, N);
+		return ret;
+	}
+	/**
+	 *  @brief 行列と行列の乗算 (出力先指定)
+	 *
+	 *  a と b の積を c に書き込む。c の領域は再利用される。
+	 *  poolを指定した場合は c を行ブロックに分割して並列に計算する。
+	 *  c は a, b のいずれとも異なるオブジェクトでなければならない。
+	 *  計算量は \f$ \mathcal{O}(NML) \f$。
+	 *
+	 *  @param[in]  a     左側の行列
+	 *  @param[in]  b     右側の行列
+	 *  @param[out] c     積の出力先
+	 *  @param[in]  pool  並列化に用いるスレッドプール (NULLなら逐次実行)
+	 */
+	static void multiply(
+		const Matrix<T> &a, const Matrix<T> &b, Matrix<T> &c,
+		misc::ThreadPool *pool = NULL)
+	{
+		assert(a.M == b.N && &c != &a && &c != &b);
+		if(c.N != a.N || c.M != b.M){
+			c.N = a.N;
+			c.M = b.M;
+			c.data.assign(c.N * c.M, T());
+		}else{
+			fill(c.data.begin(), c.data.end(), T());
+		}
+		if(!pool){
+			multiply_add(a, b, c, 0, c.N);
+			return;
 		}
+		const int BLOCK_I = 16;
+		const int blocks = (c.N + BLOCK_I - 1) / BLOCK_I;
+		pool->parallel_for(0, blocks, [&](int k){
+			multiply_add(a, b, c, k * BLOCK_I, min((k + 1) * BLOCK_I, c.N));
+		});
+	}
+
+	/**
+	 *  @brief 単位行列の生成
+	 *  @param[in] n  行列の大きさ
+	 *  @return    n次の単位行列
+	 */
+	static Matrix<T> identity(int n){
+		Matrix<T> ret(n, n);
+		for(int i = 0; i < n; ++i){ ret(i, i) = T(1); }
 		return ret;
 	}
+
+	/**
+	 *  @brief 行列の交換
+	 *  @param[in,out] m  交換する行列
+	 */
+	void swap(Matrix<T> &m){
+		std::swap(N, m.N);
+		std::swap(M, m.M);
+		data.swap(m.data);
+	}
+
 	/**
 	 *  @brief 行列と行列の乗算 + 代入
 	 *  @param[in] m  乗算する行列
 	 *  @return    自身への参照
 	 */
-	Matrix<T> &operator*=(const Matrix<T> &m){ return *this = *this * m; }
+	Matrix<T> &operator*=(const Matrix<T> &m){
+		Matrix<T> ret(N, m.M);
+		multiply(*this, m, ret);
+		swap(ret);
+		return *this;
+	}
 
 	/**
 	 *  @brief 行の入れ替え
@@ -214,7 +327,8 @@ public:
 	 */
 	void swap_rows(int a, int b){
 		if(a == b){ return; }
-		data[a].swap(data[b]);
+		swap_ranges(
+			data.begin() + a * M, data.begin() + (a + 1) * M, data.begin() + b * M);
 	}
 
 	/**
@@ -224,7 +338,7 @@ public:
 	 */
 	void swap_columns(int a, int b){
 		if(a == b){ return; }
-		for(int i = 0; i < N; ++i){ swap(data[i][a], data[i][b]); }
+		for(int i = 0; i < N; ++i){ std::swap(data[i * M + a], data[i * M + b]); }
 	}
 
 	/**
@@ -263,18 +377,66 @@ public:
 };
 
 /**
- *  @brief 行列の出力
- *  @param[in,out] os  出力先ストリーム
- *  @param[in]     m   出力する行列
- *  @return        出力先ストリーム
+ *  @brief 行列の積における被演算子の保持方法
+ *
+ *  行列はそのまま参照し、式は一度だけ行列に評価する。
+ */
+template <typename E>
+struct MatrixOperand { typedef const Matrix<typename E::value_type> type; };
+
+template <typename T>
+struct MatrixOperand< Matrix<T> > { typedef const Matrix<T> &type; };
+
+/**
+ *  @brief 式と式の乗算
+ *
+ *  行列の積は要素ごとの演算ではないため、
+ *  行列でない被演算子を先に評価してから積を計算する。
+ *  計算量は \f$ \mathcal{O}(NML) \f$。
+ *
+ *  @param[in] a  左側の行列または式
+ *  @param[in] b  右側の行列または式
+ *  @return    aとbの積
+ */
+template <typename L, typename R>
+Matrix<typename L::value_type> operator*(
+	const MatrixExpression<L> &a, const MatrixExpression<R> &b)
+{
+	typename MatrixOperand<L>::type x(a.self());
+	typename MatrixOperand<R>::type y(b.self());
+	Matrix<typename L::value_type> ret(x.rows(), y.columns());
+	Matrix<typename L::value_type>::multiply(x, y, ret);
+	return ret;
+}
+
+/**
+ *  @brief 行列の累乗
+ *
+ *  正方行列mのe乗を繰り返し二乗法で求める。
+ *  作業用の行列を使い回すため、乗算ごとの領域確保は行わない。
+ *  計算量は \f$ \mathcal{O}(N^3 \log{e}) \f$。
+ *
+ *  @param[in] m     底となる正方行列
+ *  @param[in] e     指数
+ *  @param[in] pool  並列化に用いるスレッドプール (NULLなら逐次実行)
+ *  @return    m の e 乗
  */
 template <typename T>
-ostream &operator<<(ostream &os, const Matrix<T> &m){
-	for(int i = 0; i < m.rows(); ++i){
-		for(int j = 0; j < m.columns(); ++j){ os << m(i, j) << "\t"; }
-		os << endl;
+Matrix<T> pow(const Matrix<T> &m, ull e, misc::ThreadPool *pool = NULL){
+	assert(m.rows() == m.columns());
+	const int n = m.rows();
+	Matrix<T> result = Matrix<T>::identity(n), base = m, work(n, n);
+	for(; e > 0; e >>= 1){
+		if(e & 1){
+			Matrix<T>::multiply(result, base, work, pool);
+			result.swap(work);
+		}
+		if(e > 1){
+			Matrix<T>::multiply(base, base, work, pool);
+			base.swap(work);
+		}
 	}
-	return os;
+	return result;
 }
 
 /**
@@ -0,0 +1,292 @@
+/**
+ *  @file math/matrix_expression.h
+ */
+#pragma once
+#include <iostream>
+#include <functional>
+#include <cassert>
+#include "common/header.h"
+
+namespace libcomp {
+namespace math {
+
+/**
+ *  @defgroup matrix_expression Matrix expression
+ *  @ingroup  math
+ *  @{
+ */
+
+template <typename T> class Matrix;
+
+/**
+ *  @brief 行列の要素ごとの演算を表す式の基底クラス
+ *
+ *  行列の加減算やスカラとの演算は結果の行列を作らずに式オブジェクトを返し、
+ *  Matrix への代入時に1つのループでまとめて評価される。
+ *  派生クラス E は value_type, rows(), columns() と、
+ *  行優先の通し番号による要素の取得 eval(k) と、
+ *  行番号と列番号による要素の取得 operator()(i, j) を提供する。
+ *
+ *  @tparam E  派生クラスの型
+ */
+template <typename E>
+class MatrixExpression {
+
+public:
+	/**
+	 *  @brief 派生クラスとしての参照の取得
+	 *  @return 自身への参照
+	 */
+	const E &self() const { return static_cast<const E &>(*this); }
+
+};
+
+/**
+ *  @brief 式のノードが部分式を保持する方法
+ *
+ *  行列は参照で、それ以外の式は値で保持する。
+ *  一時的な式オブジェクトが先に破棄されても参照が無効にならないようにするため。
+ */
+template <typename E>
+struct MatrixExpressionStorage { typedef const E type; };
+
+template <typename T>
+struct MatrixExpressionStorage< Matrix<T> > { typedef const Matrix<T> &type; };
+
+/**
+ *  @brief 行列同士の要素ごとの二項演算を表す式
+ */
+template <typename L, typename R, typename F>
+class MatrixBinaryExpression :
+	public MatrixExpression< MatrixBinaryExpression<L, R, F> >
+{
+
+private:
+	typename MatrixExpressionStorage<L>::type m_left;
+	typename MatrixExpressionStorage<R>::type m_right;
+	F m_func;
+
+public:
+	/// 要素の型
+	typedef typename L::value_type value_type;
+
+	/**
+	 *  @brief コンストラクタ
+	 *  @param[in] l  左側の式
+	 *  @param[in] r  右側の式
+	 *  @param[in] f  要素ごとに適用する関数
+	 */
+	MatrixBinaryExpression(const L &l, const R &r, const F &f) :
+		m_left(l), m_right(r), m_func(f)
+	{
+		assert(l.rows() == r.rows() && l.columns() == r.columns());
+	}
+
+	/// 行数の取得
+	int rows() const { return m_left.rows(); }
+	/// 列数の取得
+	int columns() const { return m_left.columns(); }
+	/// 通し番号kの要素の評価
+	value_type eval(int k) const { return m_func(m_left.eval(k), m_right.eval(k)); }
+	/// (i, j) 要素の評価
+	value_type operator()(int i, int j) const { return eval(i * columns() + j); }
+
+};
+
+/**
+ *  @brief 行列とスカラの要素ごとの二項演算を表す式
+ */
+template <typename E, typename F>
+class MatrixScalarExpression :
+	public MatrixExpression< MatrixScalarExpression<E, F> >
+{
+
+public:
+	/// 要素の型
+	typedef typename E::value_type value_type;
+
+private:
+	typename MatrixExpressionStorage<E>::type m_expr;
+	value_type m_scalar;
+	F m_func;
+
+public:
+	/**
+	 *  @brief コンストラクタ
+	 *  @param[in] e  行列側の式
+	 *  @param[in] s  スカラ
+	 *  @param[in] f  要素ごとに適用する関数
+	 */
+	MatrixScalarExpression(const E &e, const value_type &s, const F &f) :
+		m_expr(e), m_scalar(s), m_func(f)
+	{ }
+
+	/// 行数の取得
+	int rows() const { return m_expr.rows(); }
+	/// 列数の取得
+	int columns() const { return m_expr.columns(); }
+	/// 通し番号kの要素の評価
+	value_type eval(int k) const { return m_func(m_expr.eval(k), m_scalar); }
+	/// (i, j) 要素の評価
+	value_type operator()(int i, int j) const { return eval(i * columns() + j); }
+
+};
+
+/**
+ *  @brief 行列の要素ごとの単項演算を表す式
+ */
+template <typename E, typename F>
+class MatrixUnaryExpression :
+	public MatrixExpression< MatrixUnaryExpression<E, F> >
+{
+
+private:
+	typename MatrixExpressionStorage<E>::type m_expr;
+	F m_func;
+
+public:
+	/// 要素の型
+	typedef typename E::value_type value_type;
+
+	/**
+	 *  @brief コンストラクタ
+	 *  @param[in] e  対象の式
+	 *  @param[in] f  要素ごとに適用する関数
+	 */
+	MatrixUnaryExpression(const E &e, const F &f) : m_expr(e), m_func(f) { }
+
+	/// 行数の取得
+	int rows() const { return m_expr.rows(); }
+	/// 列数の取得
+	int columns() const { return m_expr.columns(); }
+	/// 通し番号kの要素の評価
+	value_type eval(int k) const { return m_func(m_expr.eval(k)); }
+	/// (i, j) 要素の評価
+	value_type operator()(int i, int j) const { return eval(i * columns() + j); }
+
+};
+
+/**
+ *  @brief 式の符号を反転
+ *  @param[in] e  対象の式
+ *  @return    すべての要素の正負を入れ替える式
+ */
+template <typename E>
+MatrixUnaryExpression< E, negate<typename E::value_type> >
+operator-(const MatrixExpression<E> &e){
+	typedef negate<typename E::value_type> F;
+	return MatrixUnaryExpression<E, F>(e.self(), F());
+}
+
+/**
+ *  @brief 式と式の加算
+ *  @param[in] a  左側の式
+ *  @param[in] b  右側の式
+ *  @return    aとbの和を表す式
+ */
+template <typename L, typename R>
+MatrixBinaryExpression< L, R, plus<typename L::value_type> >
+operator+(const MatrixExpression<L> &a, const MatrixExpression<R> &b){
+	typedef plus<typename L::value_type> F;
+	return MatrixBinaryExpression<L, R, F>(a.self(), b.self(), F());
+}
+
+/**
+ *  @brief 式と式の減算
+ *  @param[in] a  左側の式
+ *  @param[in] b  右側の式
+ *  @return    aとbの差を表す式
+ */
+template <typename L, typename R>
+MatrixBinaryExpression< L, R, minus<typename L::value_type> >
+operator-(const MatrixExpression<L> &a, const MatrixExpression<R> &b){
+	typedef minus<typename L::value_type> F;
+	return MatrixBinaryExpression<L, R, F>(a.self(), b.self(), F());
+}
+
+/**
+ *  @brief 式とスカラの加算
+ *  @param[in] e  対象の式
+ *  @param[in] s  加算するスカラ
+ *  @return    すべての要素にsを加算する式
+ */
+template <typename E>
+MatrixScalarExpression< E, plus<typename E::value_type> >
+operator+(const MatrixExpression<E> &e, const typename E::value_type &s){
+	typedef plus<typename E::value_type> F;
+	return MatrixScalarExpression<E, F>(e.self(), s, F());
+}
+
+/**
+ *  @brief 式とスカラの減算
+ *  @param[in] e  対象の式
+ *  @param[in] s  減算するスカラ
+ *  @return    すべての要素からsを減算する式
+ */
+template <typename E>
+MatrixScalarExpression< E, minus<typename E::value_type> >
+operator-(const MatrixExpression<E> &e, const typename E::value_type &s){
+	typedef minus<typename E::value_type> F;
+	return MatrixScalarExpression<E, F>(e.self(), s, F());
+}
+
+/**
+ *  @brief 式とスカラの乗算
+ *  @param[in] e  対象の式
+ *  @param[in] s  乗算するスカラ
+ *  @return    すべての要素にsを乗算する式
+ */
+template <typename E>
+MatrixScalarExpression< E, multiplies<typename E::value_type> >
+operator*(const MatrixExpression<E> &e, const typename E::value_type &s){
+	typedef multiplies<typename E::value_type> F;
+	return MatrixScalarExpression<E, F>(e.self(), s, F());
+}
+
+/**
+ *  @brief 式とスカラの除算
+ *  @param[in] e  対象の式
+ *  @param[in] s  除算するスカラ
+ *  @return    すべての要素をsで除算する式
+ */
+template <typename E>
+MatrixScalarExpression< E, divides<typename E::value_type> >
+operator/(const MatrixExpression<E> &e, const typename E::value_type &s){
+	typedef divides<typename E::value_type> F;
+	return MatrixScalarExpression<E, F>(e.self(), s, F());
+}
+
+/**
+ *  @brief 式とスカラの剰余
+ *  @param[in] e  対象の式
+ *  @param[in] s  剰余を取るスカラ
+ *  @return    すべての要素にsとの剰余をとる式
+ */
+template <typename E>
+MatrixScalarExpression< E, modulus<typename E::value_type> >
+operator%(const MatrixExpression<E> &e, const typename E::value_type &s){
+	typedef modulus<typename E::value_type> F;
+	return MatrixScalarExpression<E, F>(e.self(), s, F());
+}
+
+/**
+ *  @brief 行列の出力
+ *  @param[in,out] os  出力先ストリーム
+ *  @param[in]     e   出力する行列または式
+ *  @return        出力先ストリーム
+ */
+template <typename E>
+ostream &operator<<(ostream &os, const MatrixExpression<E> &e){
+	for(int i = 0; i < e.self().rows(); ++i){
+		for(int j = 0; j < e.self().columns(); ++j){ os << e.self()(i, j) << "\t"; }
+		os << endl;
+	}
+	return os;
+}
+
+/**
+ *  @}
+ */
+
+}
+}
@@ -0,0 +1,427 @@
+/**
+ *  @file math/mod_matrix.h
+ */
+#pragma once
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include "common/header.h"
+#include "math/barrett_reduction.h"
+#include "math/matrix.h"
+#include "misc/thread_pool.h"
+
+namespace libcomp {
+namespace math {
+
+/**
+ *  @defgroup mod_matrix Modular matrix
+ *  @ingroup  math
+ *  @{
+ */
+
+/**
+ *  @brief 剰余環上の行列
+ *
+ *  各要素を \f$ [0, m) \f$ の32bit整数として保持する行列型。
+ *  乗算では積を64bitで累積し、オーバーフローしない範囲の項数ごとに
+ *  Barrett reductionでまとめて剰余を取る。
+ *  行列式・逆行列・階数の計算は法が素数であることを仮定する。
+ */
+class ModMatrix {
+
+public:
+	/// 要素の型
+	typedef unsigned int value_type;
+
+private:
+	int N, M;
+	vector<value_type> data;
+	BarrettReduction m_barrett;
+
+	/*
+	 *  (m - 1)^2 を chunk 個加えても m 未満の値からオーバーフローしない最大の chunk (16 を上限とする)。
+	 *  m < 2^30 のときは15以上となる (998244353 では16)。
+	 */
+	int chunk_size() const {
+		const ull m = m_barrett.modulus();
+		if(m <= 2){ return 16; }
+		const ull c = (~0ull - m) / ((m - 1) * (m - 1));
+		return static_cast<int>(min<ull>(c, 16));
+	}
+
+	// 乗算で一度に処理する行数
+	static const int BLOCK_I = 16;
+
+	/*
+	 *  c の [i0, i1) 行目に a * b を書き込む。
+	 *  積は帯の大きさの作業領域に64bitで累積し、chunk 項ごとに剰余を取る。
+	 */
+	static void multiply_band(
+		const ModMatrix &a, const ModMatrix &b, ModMatrix &c, int i0, int i1)
+	{
+		const int BLOCK_K = 128, BLOCK_J = 256;
+		const int K = a.M, L = b.M;
+		const int chunk = a.chunk_size();
+		const BarrettReduction &br = a.m_barrett;
+		static thread_local vector<ull> acc;
+		acc.assign(static_cast<size_t>(i1 - i0) * L, 0);
+		for(int kk = 0; kk < K; kk += BLOCK_K){
+			const int k1 = min(kk + BLOCK_K, K);
+			for(int jj = 0; jj < L; jj += BLOCK_J){
+				const int j1 = min(jj + BLOCK_J, L);
+				for(int i = i0; i < i1; ++i){
+					ull *ci = &acc[(i - i0) * L];
+					for(int k = kk; k < k1; ){
+						const int k2 = min(k + chunk, k1);
+						for(; k < k2; ++k){
+							const ull aik = a.data[i * K + k];
+							const value_type *bk = &b.data[k * L];
+							for(int j = jj; j < j1; ++j){ ci[j] += aik * bk[j]; }
+						}
+						for(int j = jj; j < j1; ++j){ ci[j] = br.reduce(ci[j]); }
+					}
+				}
+			}
+		}
+		copy(acc.begin(), acc.end(), c.data.begin() + i0 * L);
+	}
+
+	value_type inverse_of(value_type x) const {
+		const ull m = m_barrett.modulus();
+		return m_barrett.pow(x, m - 2);
+	}
+
+	/*
+	 *  先頭 limit 列についてガウスの消去法を行い、階数を返す。
+	 *  full が真のときはピボット行を正規化して他のすべての行から消去する (Gauss-Jordan)。
+	 *  偽のときはピボットより下の行のみから消去し、det に対角成分の積と符号を累積する。
+	 *  消去は a[j][k] + (m - f) * a[r][k] < m^2 + m を1回の剰余で処理する。
+	 */
+	int eliminate(int limit, bool full, ull &det){
+		const ull m = m_barrett.modulus();
+		int r = 0;
+		det = m_barrett.reduce(1);
+		for(int c = 0; c < limit && r < N; ++c){
+			int pivot = r;
+			while(pivot < N && data[pivot * M + c] == 0){ ++pivot; }
+			if(pivot == N){ continue; }
+			if(pivot != r){
+				swap_rows(pivot, r);
+				det = (det == 0 ? 0 : m - det);
+			}
+			value_type *pr = &data[r * M];
+			det = m_barrett.multiply(det, pr[c]);
+			const ull inv = inverse_of(pr[c]);
+			if(full){
+				for(int k = c; k < M; ++k){ pr[k] = m_barrett.multiply(pr[k], inv); }
+			}
+			for(int j = (full ? 0 : r + 1); j < N; ++j){
+				value_type *pj = &data[j * M];
+				if(j == r || pj[c] == 0){ continue; }
+				const ull f = full ? pj[c] : m_barrett.multiply(pj[c], inv);
+				const ull g = m - f;
+				for(int k = c; k < M; ++k){ pj[k] = m_barrett.reduce(pj[k] + g * pr[k]); }
+			}
+			++r;
+		}
+		return r;
+	}
+
+public:
+	/**
+	 *  @brief コンストラクタ
+	 *
+	 *  すべての要素が0の行列を構築する。
+	 *
+	 *  @param[in] N    行列の行数
+	 *  @param[in] M    行列の列数
+	 *  @param[in] mod  法 (1 <= mod < 2^32)
+	 */
+	ModMatrix(int N, int M, ull mod) :
+		N(N), M(M), data(N * M), m_barrett(mod)
+	{ }
+
+	/**
+	 *  @brief コンストラクタ
+	 *
+	 *  整数行列の各要素を法modで正規化した行列を構築する。
+	 *
+	 *  @param[in] m    元となる行列
+	 *  @param[in] mod  法 (1 <= mod < 2^32)
+	 */
+	ModMatrix(const Matrix<ll> &m, ull mod) :
+		N(m.rows()), M(m.columns()), data(N * M), m_barrett(mod)
+	{
+		const ll smod = static_cast<ll>(mod);
+		for(int i = 0; i < N; ++i){
+			for(int j = 0; j < M; ++j){
+				const ll x = m(i, j) % smod;
+				data[i * M + j] = static_cast<value_type>(x < 0 ? x + smod : x);
+			}
+		}
+	}
+
+	/**
+	 *  @brief 行列の行数の取得
+	 *  @return 行列の行数
+	 */
+	int rows() const { return N; }
+	/**
+	 *  @brief 行列の列数の取得
+	 *  @return 行列の列数
+	 */
+	int columns() const { return M; }
+	/**
+	 *  @brief 法の取得
+	 *  @return 法
+	 */
+	ull modulus() const { return m_barrett.modulus(); }
+
+	/**
+	 *  @brief 行列内の要素の取得
+	 *  @param[in] i  取得したい要素の行番号
+	 *  @param[in] j  取得したい要素の列番号
+	 *  @return    指定したインデックスに対応する要素への参照
+	 */
+	const value_type &operator()(int i, int j) const { return data[i * M + j]; }
+	/**
+	 *  @brief 行列内の要素の取得
+	 *
+	 *  書き込む値は法未満でなければならない。
+	 *
+	 *  @param[in] i  取得したい要素の行番号
+	 *  @param[in] j  取得したい要素の列番号
+	 *  @return    指定したインデックスに対応する要素への参照
+	 */
+	value_type &operator()(int i, int j){ return data[i * M + j]; }
+
+	/**
+	 *  @brief 行列と行列の加算
+	 *  @param[in] m  加算する行列
+	 *  @return    (*this)とmの和
+	 */
+	ModMatrix operator+(const ModMatrix &m) const {
+		assert(N == m.N && M == m.M && modulus() == m.modulus());
+		const value_type mod = modulus();
+		ModMatrix ret(N, M, mod);
+		for(int i = 0; i < N * M; ++i){
+			const value_type x = data[i] + m.data[i];
+			ret.data[i] = (x >= mod || x < data[i]) ? x - mod : x;
+		}
+		return ret;
+	}
+
+	/**
+	 *  @brief 行列と行列の減算
+	 *  @param[in] m  減算する行列
+	 *  @return    (*this)とmの差
+	 */
+	ModMatrix operator-(const ModMatrix &m) const {
+		assert(N == m.N && M == m.M && modulus() == m.modulus());
+		const value_type mod = modulus();
+		ModMatrix ret(N, M, mod);
+		for(int i = 0; i < N * M; ++i){
+			const value_type x = data[i] - m.data[i];
+			ret.data[i] = data[i] < m.data[i] ? x + mod : x;
+		}
+		return ret;
+	}
+
+	/**
+	 *  @brief 行列とスカラの乗算
+	 *  @param[in] s  乗算するスカラ (s < 法)
+	 *  @return    すべての要素にsを乗算した行列
+	 */
+	ModMatrix operator*(value_type s) const {
+		ModMatrix ret(N, M, modulus());
+		for(int i = 0; i < N * M; ++i){ ret.data[i] = m_barrett.multiply(data[i], s); }
+		return ret;
+	}
+
+	/**
+	 *  @brief 行列と行列の乗算
+	 *
+	 *  計算量は \f$ \mathcal{O}(NML) \f$。
+	 *
+	 *  @param[in] m  乗算する行列
+	 *  @return    (*this)とmの積
+	 */
+	ModMatrix operator*(const ModMatrix &m) const {
+		ModMatrix ret(N, m.M, modulus());
+		multiply(*this, m, ret);
+		return ret;
+	}
+
+	/**
+	 *  @brief 行列と行列の乗算 (出力先指定)
+	 *
+	 *  a と b の積を c に書き込む。
+	 *  c は a, b のいずれとも異なるオブジェクトでなければならない。
+	 *  計算量は \f$ \mathcal{O}(NML) \f$。
+	 *
+	 *  @param[in]  a     左側の行列
+	 *  @param[in]  b     右側の行列
+	 *  @param[out] c     積の出力先
+	 *  @param[in]  pool  並列化に用いるスレッドプール (NULLなら逐次実行)
+	 */
+	static void multiply(
+		const ModMatrix &a, const ModMatrix &b, ModMatrix &c,
+		misc::ThreadPool *pool = NULL)
+	{
+		assert(a.M == b.N && a.modulus() == b.modulus());
+		assert(&c != &a && &c != &b);
+		c.N = a.N;
+		c.M = b.M;
+		c.m_barrett = a.m_barrett;
+		c.data.resize(c.N * c.M);
+		const int blocks = (c.N + BLOCK_I - 1) / BLOCK_I;
+		if(!pool){
+			for(int k = 0; k < blocks; ++k){
+				multiply_band(a, b, c, k * BLOCK_I, min((k + 1) * BLOCK_I, c.N));
+			}
+		}else{
+			pool->parallel_for(0, blocks, [&](int k){
+				multiply_band(a, b, c, k * BLOCK_I, min((k + 1) * BLOCK_I, c.N));
+			});
+		}
+	}
+
+	/**
+	 *  @brief 単位行列の生成
+	 *  @param[in] n    行列の大きさ
+	 *  @param[in] mod  法
+	 *  @return    n次の単位行列
+	 */
+	static ModMatrix identity(int n, ull mod){
+		ModMatrix ret(n, n, mod);
+		const value_type one = static_cast<value_type>(1 % mod);
+		for(int i = 0; i < n; ++i){ ret(i, i) = one; }
+		return ret;
+	}
+
+	/**
+	 *  @brief 行列の累乗
+	 *
+	 *  計算量は \f$ \mathcal{O}(N^3 \log{e}) \f$。
+	 *
+	 *  @param[in] e     指数
+	 *  @param[in] pool  並列化に用いるスレッドプール (NULLなら逐次実行)
+	 *  @return    (*this) の e 乗
+	 */
+	ModMatrix pow(ull e, misc::ThreadPool *pool = NULL) const {
+		assert(N == M);
+		ModMatrix result = identity(N, modulus()), base = *this, work(N, N, modulus());
+		for(; e > 0; e >>= 1){
+			if(e & 1){
+				multiply(result, base, work, pool);
+				result.swap(work);
+			}
+			if(e > 1){
+				multiply(base, base, work, pool);
+				base.swap(work);
+			}
+		}
+		return result;
+	}
+
+	/**
+	 *  @brief 行列の交換
+	 *  @param[in,out] m  交換する行列
+	 */
+	void swap(ModMatrix &m){
+		std::swap(N, m.N);
+		std::swap(M, m.M);
+		data.swap(m.data);
+		std::swap(m_barrett, m.m_barrett);
+	}
+
+	/**
+	 *  @brief 行の入れ替え
+	 *  @param[in] a  入れ替える行
+	 *  @param[in] b  入れ替える行
+	 */
+	void swap_rows(int a, int b){
+		if(a == b){ return; }
+		swap_ranges(
+			data.begin() + a * M, data.begin() + (a + 1) * M, data.begin() + b * M);
+	}
+
+	/**
+	 *  @brief 行列式
+	 *
+	 *  法が素数であるとき、正方行列の行列式を求める。
+	 *  計算量は \f$ \mathcal{O}(N^3) \f$。
+	 *
+	 *  @return 行列式の値
+	 */
+	value_type determinant() const {
+		assert(N == M);
+		ModMatrix a(*this);
+		ull det;
+		if(a.eliminate(M, false, det) < N){ return 0; }
+		return static_cast<value_type>(det);
+	}
+
+	/**
+	 *  @brief 逆行列
+	 *
+	 *  法が素数であるとき、正方行列の逆行列を求める。
+	 *  計算量は \f$ \mathcal{O}(N^3) \f$。
+	 *
+	 *  @return 逆行列。正則でない場合は 0x0 の行列を返す。
+	 */
+	ModMatrix inverse() const {
+		assert(N == M);
+		ModMatrix a(N, 2 * N, modulus());
+		const value_type one = static_cast<value_type>(1 % modulus());
+		for(int i = 0; i < N; ++i){
+			copy(data.begin() + i * M, data.begin() + (i + 1) * M, a.data.begin() + i * 2 * N);
+			a(i, N + i) = one;
+		}
+		ull det;
+		if(a.eliminate(N, true, det) < N){ return ModMatrix(0, 0, modulus()); }
+		ModMatrix ret(N, N, modulus());
+		for(int i = 0; i < N; ++i){
+			copy(a.data.begin() + i * 2 * N + N, a.data.begin() + (i + 1) * 2 * N,
+			     ret.data.begin() + i * N);
+		}
+		return ret;
+	}
+
+	/**
+	 *  @brief 行列の階数
+	 *
+	 *  法が素数であるとき、行列の階数を求める。
+	 *  計算量は \f$ \mathcal{O}(N^2 M) \f$。
+	 *
+	 *  @return 行列の階数
+	 */
+	int rank() const {
+		ModMatrix a(*this);
+		ull det;
+		return a.eliminate(M, false, det);
+	}
+
+};
+
+/**
+ *  @brief 行列の出力
+ *  @param[in,out] os  出力先ストリーム
+ *  @param[in]     m   出力する行列
+ *  @return        出力先ストリーム
+ */
+inline ostream &operator<<(ostream &os, const ModMatrix &m){
+	for(int i = 0; i < m.rows(); ++i){
+		for(int j = 0; j < m.columns(); ++j){ os << m(i, j) << "\t"; }
+		os << endl;
+	}
+	return os;
+}
+
+/**
+ *  @}
+ */
+
+}
+}
@@ -0,0 +1,120 @@
+/**
+ *  @file math/montgomery_reduction.h
+ */
+#pragma once
+#include <cassert>
+#include "common/header.h"
+
+namespace libcomp {
+namespace math {
+
+/**
+ *  @defgroup montgomery_reduction Montgomery reduction
+ *  @ingroup  math
+ *  @{
+ */
+
+/**
+ *  @brief Montgomery乗算による剰余計算
+ *
+ *  奇数の法 m と \f$ R = 2^{32} \f$ について、
+ *  値 x を \f$ xR \bmod m \f$ (Montgomery表現) で扱い、
+ *  剰余上の乗算を除算命令を使わずに乗算とシフトのみで行う。
+ *  \f$ -m^{-1} \bmod R \f$ と \f$ R^2 \bmod m \f$ を前計算しておく。
+ */
+class MontgomeryReduction {
+
+private:
+	unsigned int m_mod;
+	unsigned int m_inv;
+	unsigned int m_r2;
+
+public:
+	/**
+	 *  @brief コンストラクタ
+	 *  @param[in] mod  法 (奇数、1 <= mod < 2^31)
+	 */
+	explicit MontgomeryReduction(unsigned int mod = 1) :
+		m_mod(mod), m_inv(0), m_r2(0)
+	{
+		assert(mod % 2 == 1 && mod < (1u << 31));
+		// Newton法により mod^{-1} mod 2^32 を求める
+		unsigned int inv = mod;
+		for(int i = 0; i < 4; ++i){ inv *= 2 - mod * inv; }
+		m_inv = -inv;
+		// R^2 = 2^64 ≡ 2^64 - mod
+		m_r2 = static_cast<unsigned int>((-static_cast<ull>(mod)) % mod);
+	}
+
+	/**
+	 *  @brief 法の取得
+	 *  @return 法
+	 */
+	unsigned int modulus() const { return m_mod; }
+
+	/**
+	 *  @brief Montgomery reduction
+	 *  @param[in] t  対象とする値 (t < mR)
+	 *  @return    \f$ tR^{-1} \bmod m \f$
+	 */
+	unsigned int reduce(ull t) const {
+		const unsigned int u = static_cast<unsigned int>(t) * m_inv;
+		const unsigned int r = static_cast<unsigned int>((t + static_cast<ull>(u) * m_mod) >> 32);
+		return r >= m_mod ? r - m_mod : r;
+	}
+
+	/**
+	 *  @brief Montgomery表現への変換
+	 *  @param[in] x  変換する値 (x < m)
+	 *  @return    \f$ xR \bmod m \f$
+	 */
+	unsigned int transform(unsigned int x) const {
+		return reduce(static_cast<ull>(x) * m_r2);
+	}
+
+	/**
+	 *  @brief Montgomery表現からの復元
+	 *  @param[in] x  Montgomery表現の値
+	 *  @return    \f$ xR^{-1} \bmod m \f$
+	 */
+	unsigned int restore(unsigned int x) const { return reduce(x); }
+
+	/**
+	 *  @brief Montgomery表現での乗算
+	 *
+	 *  一方のみがMontgomery表現であれば、結果は通常の表現での積となる。
+	 *
+	 *  @param[in] a  乗算する値 (a < m)
+	 *  @param[in] b  乗算する値 (b < m)
+	 *  @return    \f$ abR^{-1} \bmod m \f$
+	 */
+	unsigned int multiply(unsigned int a, unsigned int b) const {
+		return reduce(static_cast<ull>(a) * b);
+	}
+
+	/**
+	 *  @brief Montgomery表現での累乗
+	 *
+	 *  計算量は \f$ \mathcal{O}(\log{e}) \f$。
+	 *
+	 *  @param[in] a  底 (Montgomery表現)
+	 *  @param[in] e  指数
+	 *  @return    \f$ a^e \f$ (Montgomery表現)
+	 */
+	unsigned int pow(unsigned int a, ull e) const {
+		unsigned int r = transform(1);
+		for(; e > 0; e >>= 1){
+			if(e & 1){ r = multiply(r, a); }
+			a = multiply(a, a);
+		}
+		return r;
+	}
+
+};
+
+/**
+ *  @}
+ */
+
+}
+}
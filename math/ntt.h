@@ -0,0 +1,370 @@
+/**
+ *  @file math/ntt.h
+ */
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include "common/header.h"
+#include "math/montgomery_reduction.h"
+
+namespace libcomp {
+namespace math {
+
+/**
+ *  @defgroup ntt NTT
+ *  @ingroup  math
+ *  @{
+ */
+
+/**
+ *  @brief 数論変換
+ *
+ *  素数 p を法とする高速数論変換。p - 1 が 2^k で割り切れるとき、
+ *  大きさ 2^k までの変換を扱える。
+ *  回転因子は段ごとに連続した領域にMontgomery表現で並べて保持し、
+ *  必要な大きさまで必要になった時点で拡張する。
+ *  データは通常の表現のまま扱い、回転因子との積をMontgomery乗算1回で求める。
+ *  順変換は周波数間引き (自然順 → ビット反転順)、逆変換は時間間引き
+ *  (ビット反転順 → 自然順) で行うため、畳み込みでは並べ替えが不要になる。
+ *  BLOCK 要素以下の段はブロックごとにまとめて処理し、キャッシュ上で完結させる。
+ */
+class NumberTheoreticTransform {
+
+private:
+	static const int BLOCK = 1 << 13;
+
+	MontgomeryReduction m_mr;
+	unsigned int m_mod;
+	unsigned int m_root;
+	int m_max_log;
+	vector<unsigned int> m_roots;
+	vector<unsigned int> m_inv_roots;
+
+	unsigned int add(unsigned int a, unsigned int b) const {
+		const unsigned int c = a + b;
+		return c >= m_mod ? c - m_mod : c;
+	}
+
+	unsigned int sub(unsigned int a, unsigned int b) const {
+		return a >= b ? a - b : a + m_mod - b;
+	}
+
+	// 長さ total の区間に対して長さ L 以下の段をすべて行う
+	void forward_stages(unsigned int *a, int total, int L) const {
+		for(int k = L >> 1; k >= 1; k >>= 1){
+			const unsigned int *w = &m_roots[k];
+			for(int i = 0; i < total; i += 2 * k){
+				unsigned int *x = a + i, *y = a + i + k;
+				for(int j = 0; j < k; ++j){
+					const unsigned int u = x[j], v = y[j];
+					x[j] = add(u, v);
+					y[j] = m_mr.multiply(u + m_mod - v, w[j]);
+				}
+			}
+		}
+	}
+
+	void inverse_stages(unsigned int *a, int total, int L) const {
+		for(int k = 1; k < L; k <<= 1){ inverse_stage(a, total, k); }
+	}
+
+	void inverse_stage(unsigned int *a, int total, int k) const {
+		const unsigned int *w = &m_inv_roots[k];
+		for(int i = 0; i < total; i += 2 * k){
+			unsigned int *x = a + i, *y = a + i + k;
+			for(int j = 0; j < k; ++j){
+				const unsigned int u = x[j], v = m_mr.multiply(y[j], w[j]);
+				x[j] = add(u, v);
+				y[j] = sub(u, v);
+			}
+		}
+	}
+
+public:
+	/**
+	 *  @brief コンストラクタ
+	 *  @param[in] mod   法 (奇素数、mod < 2^31)
+	 *  @param[in] root  法 mod での原始根
+	 */
+	NumberTheoreticTransform(unsigned int mod = 998244353, unsigned int root = 3) :
+		m_mr(mod), m_mod(mod), m_root(root),
+		m_max_log(__builtin_ctz(mod - 1)), m_roots(2), m_inv_roots(2)
+	{
+		m_roots[1] = m_inv_roots[1] = m_mr.transform(1);
+	}
+
+	/**
+	 *  @brief 法の取得
+	 *  @return 法
+	 */
+	unsigned int modulus() const { return m_mod; }
+
+	/**
+	 *  @brief 扱える変換の大きさの上限の取得
+	 *  @return 扱える最大の変換の大きさ
+	 */
+	int max_size() const { return 1 << m_max_log; }
+
+	/**
+	 *  @brief 回転因子の表の拡張
+	 *
+	 *  大きさnまでの変換に必要な回転因子を求める。
+	 *  各変換の関数からも呼ばれるため、明示的に呼ぶ必要はない。
+	 *  計算量は \f$ \mathcal{O}(n) \f$。
+	 *
+	 *  @param[in] n  変換の大きさ (2のべき乗、max_size() 以下であること)
+	 */
+	void reserve(int n){
+		assert(n > 0 && (n & (n - 1)) == 0 && n <= max_size());
+		for(int k = m_roots.size(); k < n; k <<= 1){
+			// 1の原始 2k 乗根
+			const ull e = (m_mod - 1) / (2 * k);
+			const unsigned int w = m_mr.pow(m_mr.transform(m_root), e);
+			const unsigned int iw = m_mr.pow(w, 2 * k - 1);
+			m_roots.resize(2 * k);
+			m_inv_roots.resize(2 * k);
+			for(int j = 0; j < k; j += 2){
+				m_roots[k + j] = m_roots[k / 2 + j / 2];
+				m_inv_roots[k + j] = m_inv_roots[k / 2 + j / 2];
+				m_roots[k + j + 1] = m_mr.multiply(m_roots[k + j], w);
+				m_inv_roots[k + j + 1] = m_mr.multiply(m_inv_roots[k + j], iw);
+			}
+		}
+	}
+
+	/**
+	 *  @brief ビット反転順への変換
+	 *
+	 *  自然な順序の列を変換し、結果をビット反転した順序で出力する。
+	 *  計算量は \f$ \mathcal{O}(n \log{n}) \f$。
+	 *
+	 *  @param[in,out] a  変換する列 (各要素は mod 未満)
+	 *  @param[in]     n  変換の大きさ (2のべき乗、max_size() 以下であること)
+	 */
+	void forward_to_bit_reversed(unsigned int *a, int n){
+		reserve(n);
+		int L = n;
+		for(; L > BLOCK; L >>= 1){
+			const int k = L >> 1;
+			const unsigned int *w = &m_roots[k];
+			for(int i = 0; i < n; i += L){
+				unsigned int *x = a + i, *y = a + i + k;
+				for(int j = 0; j < k; ++j){
+					const unsigned int u = x[j], v = y[j];
+					x[j] = add(u, v);
+					y[j] = m_mr.multiply(u + m_mod - v, w[j]);
+				}
+			}
+		}
+		for(int i = 0; i < n; i += L){ forward_stages(a + i, L, L); }
+	}
+
+	/**
+	 *  @brief ビット反転順からの逆変換
+	 *
+	 *  forward_to_bit_reversed の逆変換。1/n 倍の正規化は行わない。
+	 *  計算量は \f$ \mathcal{O}(n \log{n}) \f$。
+	 *
+	 *  @param[in,out] a  変換する列 (各要素は mod 未満)
+	 *  @param[in]     n  変換の大きさ (2のべき乗、max_size() 以下であること)
+	 */
+	void inverse_from_bit_reversed(unsigned int *a, int n){
+		reserve(n);
+		const int L = (n < BLOCK ? n : BLOCK);
+		for(int i = 0; i < n; i += L){ inverse_stages(a + i, L, L); }
+		for(int k = L; k < n; k <<= 1){ inverse_stage(a, n, k); }
+	}
+
+	/**
+	 *  @brief 列の変換
+	 *
+	 *  自然な順序で入出力する変換。逆変換では 1/n 倍の正規化も行う。
+	 *  計算量は \f$ \mathcal{O}(n \log{n}) \f$。
+	 *
+	 *  @param[in,out] a        変換する列 (大きさは2のべき乗、各要素は mod 未満)
+	 *  @param[in]     inverse  逆変換を行う場合にtrueを指定する
+	 */
+	void transform(vector<unsigned int> &a, bool inverse = false){
+		const int n = a.size();
+		if(inverse){
+			for(int i = 0, j = 1; j < n - 1; ++j){
+				for(int k = n >> 1; k > (i ^= k); k >>= 1){ }
+				if(j < i){ swap(a[i], a[j]); }
+			}
+			inverse_from_bit_reversed(a.data(), n);
+			const unsigned int r = m_mr.transform(inverse_of(n));
+			for(int i = 0; i < n; ++i){ a[i] = m_mr.multiply(a[i], r); }
+		}else{
+			forward_to_bit_reversed(a.data(), n);
+			for(int i = 0, j = 1; j < n - 1; ++j){
+				for(int k = n >> 1; k > (i ^= k); k >>= 1){ }
+				if(j < i){ swap(a[i], a[j]); }
+			}
+		}
+	}
+
+	/**
+	 *  @brief 剰余上の乗算
+	 *  @param[in] a  乗算する値 (a < mod)
+	 *  @param[in] b  乗算する値 (b < mod)
+	 *  @return    \f$ ab \bmod \mathit{mod} \f$
+	 */
+	unsigned int multiply(unsigned int a, unsigned int b) const {
+		return m_mr.multiply(m_mr.transform(a), b);
+	}
+
+	/**
+	 *  @brief 剰余上の逆元
+	 *  @param[in] a  対象とする値 (0 < a < mod)
+	 *  @return    \f$ a^{-1} \bmod \mathit{mod} \f$
+	 */
+	unsigned int inverse_of(unsigned int a) const {
+		return m_mr.restore(m_mr.pow(m_mr.transform(a), m_mod - 2));
+	}
+
+	/**
+	 *  @brief 畳み込み
+	 *
+	 *  短い方の列が十分に短ければ素朴な方法で計算する。
+	 *  各点ごとの積で生じる \f$ R^{-1} \f$ の因子は正規化の係数にまとめて打ち消す。
+	 *  計算量は \f$ \mathcal{O}(n \log{n}) \f$ (n = |a|+|b|)。
+	 *
+	 *  @param[in] a  1つ目の列 (各要素は mod 未満)
+	 *  @param[in] b  2つ目の列 (各要素は mod 未満)
+	 *  @return    a と b の mod 上での畳み込み (大きさ |a|+|b|-1、どちらかが空なら空)
+	 */
+	vector<unsigned int> convolve(const vector<unsigned int> &a, const vector<unsigned int> &b){
+		if(a.empty() || b.empty()){ return vector<unsigned int>(); }
+		const int size = a.size() + b.size() - 1;
+		if(min(a.size(), b.size()) <= 32){
+			vector<unsigned int> c(size);
+			for(size_t i = 0; i < a.size(); ++i){
+				const unsigned int x = m_mr.transform(a[i]);
+				for(size_t j = 0; j < b.size(); ++j){
+					c[i + j] = add(c[i + j], m_mr.multiply(x, b[j]));
+				}
+			}
+			return c;
+		}
+		int n = 1;
+		while(n < size){ n <<= 1; }
+		vector<unsigned int> fa(n), fb;
+		copy(a.begin(), a.end(), fa.begin());
+		forward_to_bit_reversed(fa.data(), n);
+		if(&a == &b){
+			fb = fa;
+		}else{
+			fb.assign(n, 0);
+			copy(b.begin(), b.end(), fb.begin());
+			forward_to_bit_reversed(fb.data(), n);
+		}
+		for(int i = 0; i < n; ++i){ fa[i] = m_mr.multiply(fa[i], fb[i]); }
+		inverse_from_bit_reversed(fa.data(), n);
+		// R^2 / n を掛けると、各点ごとの積で生じた R^{-1} と正規化の 1/n をまとめて処理できる
+		const unsigned int r = m_mr.transform(m_mr.transform(inverse_of(n)));
+		for(int i = 0; i < size; ++i){ fa[i] = m_mr.multiply(fa[i], r); }
+		fa.resize(size);
+		return fa;
+	}
+
+};
+
+/**
+ *  @brief 3つの素数を法とする畳み込みの係数の混合基数表現
+ *
+ *  係数 x を \f$ x = t_1 + t_2 M_1 + t_3 M_1 M_2 \f$
+ *  (\f$ 0 \leq t_i < M_i \f$) と表したときの各桁。
+ */
+struct GarnerDigits {
+	/// 1つ目の素数
+	static const unsigned int M1 = 167772161;
+	/// 2つ目の素数
+	static const unsigned int M2 = 469762049;
+	/// 3つ目の素数
+	static const unsigned int M3 = 754974721;
+
+	unsigned int t1;
+	unsigned int t2;
+	unsigned int t3;
+};
+
+/**
+ *  @brief 3つの素数を法とする畳み込み
+ *
+ *  GarnerDigits の3つの素数でそれぞれ畳み込みを求め、
+ *  中国剰余定理 (Garner のアルゴリズム) で各係数の混合基数表現を求める。
+ *  各係数が \f$ M_1 M_2 M_3 \approx 6 \cdot 10^{25} \f$ 未満であれば厳密な値を表す。
+ *  計算量は \f$ \mathcal{O}(n \log{n}) \f$ (n = |a|+|b|)。
+ *
+ *  @param[in] a  1つ目の列
+ *  @param[in] b  2つ目の列
+ *  @return    各係数の混合基数表現 (大きさ |a|+|b|-1、どちらかが空なら空)
+ */
+inline vector<GarnerDigits> convolve_three_primes(
+	const vector<unsigned int> &a, const vector<unsigned int> &b)
+{
+	const unsigned int M1 = GarnerDigits::M1, M2 = GarnerDigits::M2, M3 = GarnerDigits::M3;
+	static thread_local NumberTheoreticTransform ntt1(M1, 3), ntt2(M2, 3), ntt3(M3, 11);
+	if(a.empty() || b.empty()){ return vector<GarnerDigits>(); }
+	struct Residue {
+		static vector<unsigned int> convolve(
+			NumberTheoreticTransform &ntt,
+			const vector<unsigned int> &a, const vector<unsigned int> &b)
+		{
+			const unsigned int m = ntt.modulus();
+			vector<unsigned int> ra(a), rb(b);
+			for(size_t i = 0; i < ra.size(); ++i){ ra[i] %= m; }
+			for(size_t i = 0; i < rb.size(); ++i){ rb[i] %= m; }
+			return ntt.convolve(ra, rb);
+		}
+	};
+	const vector<unsigned int> c1 = Residue::convolve(ntt1, a, b);
+	const vector<unsigned int> c2 = Residue::convolve(ntt2, a, b);
+	const vector<unsigned int> c3 = Residue::convolve(ntt3, a, b);
+	const ull inv_m1_m2 = ntt2.inverse_of(M1);
+	const ull inv_m1m2_m3 = ntt3.inverse_of(static_cast<ull>(M1) * M2 % M3);
+	vector<GarnerDigits> c(c1.size());
+	for(size_t i = 0; i < c.size(); ++i){
+		const ull t1 = c1[i];
+		const ull t2 = (c2[i] + M2 - t1 % M2) % M2 * inv_m1_m2 % M2;
+		const ull t3 =
+			(c3[i] + 2ull * M3 - t1 % M3 - t2 * M1 % M3) % M3 * inv_m1m2_m3 % M3;
+		c[i].t1 = t1;
+		c[i].t2 = t2;
+		c[i].t3 = t3;
+	}
+	return c;
+}
+
+/**
+ *  @brief 任意の法での畳み込み
+ *
+ *  convolve_three_primes で求めた係数を mod で割った余りに直す。
+ *  mod <= 2^30 かつ |a|+|b|-1 <= 2^24 であれば厳密な値が得られる。
+ *  計算量は \f$ \mathcal{O}(n \log{n}) \f$ (n = |a|+|b|)。
+ *
+ *  @param[in] a    1つ目の列 (各要素は mod 未満)
+ *  @param[in] b    2つ目の列 (各要素は mod 未満)
+ *  @param[in] mod  法
+ *  @return    a と b の mod 上での畳み込み (大きさ |a|+|b|-1、どちらかが空なら空)
+ */
+inline vector<unsigned int> convolve_mod(
+	const vector<unsigned int> &a, const vector<unsigned int> &b, unsigned int mod)
+{
+	const vector<GarnerDigits> d = convolve_three_primes(a, b);
+	const ull m1_mod = GarnerDigits::M1 % mod;
+	const ull m1m2_mod = static_cast<ull>(GarnerDigits::M1) * GarnerDigits::M2 % mod;
+	vector<unsigned int> c(d.size());
+	for(size_t i = 0; i < c.size(); ++i){
+		c[i] = (d[i].t1 % mod + d[i].t2 * m1_mod % mod + d[i].t3 * m1m2_mod % mod) % mod;
+	}
+	return c;
+}
+
+/**
+ *  @}
+ */
+
+}
+}
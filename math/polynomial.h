@@ -0,0 +1,466 @@
+/**
+ *  @file math/polynomial.h
+ */
+#pragma once
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cassert>
+#include "common/header.h"
+#include "math/ntt.h"
+
+namespace libcomp {
+namespace math {
+
+/**
+ *  @defgroup polynomial Polynomial
+ *  @ingroup  math
+ *  @{
+ */
+
+/**
+ *  @brief 素数を法とする多項式・形式的冪級数の演算
+ *
+ *  係数を mod 未満の値の列 (添字 i が x^i の係数) として表し、
+ *  NumberTheoreticTransform による畳み込みの上に各演算を構成する。
+ *  逆元・指数関数などのNewton法では、既知の下位の係数が巡回畳み込みの
+ *  折り返しで壊れる部分にだけ現れるように変換長を選び (middle product)、
+ *  1回の反復あたりの変換の回数を減らしている。
+ *  反復で用いる作業領域はメンバとして保持し、反復間・呼び出し間で再利用する。
+ *  そのため、同じオブジェクトを複数のスレッドから同時に用いてはならない。
+ */
+class PolynomialRing {
+
+private:
+	static const int LEAF = 32;
+
+	NumberTheoreticTransform m_ntt;
+	unsigned int m_mod;
+	vector<unsigned int> m_inverses;
+	vector<unsigned int> m_x, m_y, m_z;
+
+	unsigned int add(unsigned int a, unsigned int b) const {
+		const unsigned int c = a + b;
+		return c >= m_mod ? c - m_mod : c;
+	}
+
+	unsigned int sub(unsigned int a, unsigned int b) const {
+		return a >= b ? a - b : a + m_mod - b;
+	}
+
+	unsigned int mul(unsigned int a, unsigned int b) const { return m_ntt.multiply(a, b); }
+
+	unsigned int pow(unsigned int a, ull e) const {
+		ull r = 1, x = a;
+		for(; e > 0; e >>= 1){
+			if(e & 1){ r = r * x % m_mod; }
+			x = x * x % m_mod;
+		}
+		return r;
+	}
+
+	// 1, 2, ..., n の逆元の表を用意する
+	void prepare_inverses(int n){
+		if(m_inverses.size() < 2){ m_inverses.assign(2, 1); }
+		for(int i = m_inverses.size(); i <= n; ++i){
+			m_inverses.push_back(sub(0, mul(m_mod / i, m_inverses[m_mod % i])));
+		}
+	}
+
+	void forward_transform(vector<unsigned int> &a, int n){
+		a.resize(n);
+		m_ntt.forward_to_bit_reversed(a.data(), n);
+	}
+
+	void inverse_transform(vector<unsigned int> &a, int n){
+		m_ntt.inverse_from_bit_reversed(a.data(), n);
+		const unsigned int r = m_ntt.inverse_of(n);
+		for(int i = 0; i < n; ++i){ a[i] = mul(a[i], r); }
+	}
+
+	void pointwise(vector<unsigned int> &a, const vector<unsigned int> &b, int n) const {
+		for(int i = 0; i < n; ++i){ a[i] = mul(a[i], b[i]); }
+	}
+
+	// 法 mod での平方根 (Tonelli-Shanks)。存在しなければ -1。
+	ll sqrt_mod(unsigned int a) const {
+		if(a == 0 || m_mod == 2){ return a; }
+		if(pow(a, (m_mod - 1) / 2) != 1){ return -1; }
+		unsigned int q = m_mod - 1, s = 0, z = 2;
+		while(q % 2 == 0){ q /= 2; ++s; }
+		while(pow(z, (m_mod - 1) / 2) == 1){ ++z; }
+		unsigned int c = pow(z, q), t = pow(a, q), r = pow(a, (q + 1) / 2);
+		while(t != 1){
+			unsigned int i = 0, u = t;
+			while(u != 1){
+				u = mul(u, u);
+				++i;
+			}
+			unsigned int b = c;
+			for(unsigned int j = 0; j + 1 < s - i; ++j){ b = mul(b, b); }
+			r = mul(r, b);
+			c = mul(b, b);
+			t = mul(t, c);
+			s = i;
+		}
+		return min(r, m_mod - r);
+	}
+
+	// 部分積木: tree[v] は担当する点 xs[l, r) について prod (x - xs[i])
+	void build(
+		vector< vector<unsigned int> > &tree, const vector<unsigned int> &xs,
+		int v, int l, int r)
+	{
+		if(r - l <= LEAF){
+			vector<unsigned int> &p = tree[v];
+			p.assign(1, 1);
+			for(int i = l; i < r; ++i){
+				p.push_back(0);
+				for(int j = p.size() - 1; j >= 0; --j){
+					p[j] = sub(j > 0 ? p[j - 1] : 0, mul(p[j], xs[i]));
+				}
+			}
+			return;
+		}
+		const int c = (l + r) / 2;
+		build(tree, xs, 2 * v, l, c);
+		build(tree, xs, 2 * v + 1, c, r);
+		tree[v] = multiply(tree[2 * v], tree[2 * v + 1]);
+	}
+
+	// 剰余木: f mod tree[v] を子へ伝えて xs[l, r) での値を求める
+	void evaluate(
+		const vector< vector<unsigned int> > &tree, const vector<unsigned int> &xs,
+		vector<unsigned int> f, int v, int l, int r, vector<unsigned int> &ys)
+	{
+		if(r - l <= LEAF){
+			for(int i = l; i < r; ++i){
+				unsigned int y = 0;
+				for(int j = f.size() - 1; j >= 0; --j){ y = add(mul(y, xs[i]), f[j]); }
+				ys[i] = y;
+			}
+			return;
+		}
+		const int c = (l + r) / 2;
+		evaluate(tree, xs, divide(f, tree[2 * v]).second, 2 * v, l, c, ys);
+		evaluate(tree, xs, divide(f, tree[2 * v + 1]).second, 2 * v + 1, c, r, ys);
+	}
+
+	// sum_i w[i] prod_{j != i} (x - xs[j]) を xs[l, r) について求める
+	vector<unsigned int> combine(
+		const vector< vector<unsigned int> > &tree, const vector<unsigned int> &xs,
+		const vector<unsigned int> &w, int v, int l, int r)
+	{
+		if(r - l <= LEAF){
+			const vector<unsigned int> &p = tree[v];
+			vector<unsigned int> result(r - l, 0);
+			for(int i = l; i < r; ++i){
+				// p / (x - xs[i]) を組立除法で求めて加える
+				unsigned int q = 0;
+				for(int j = r - l; j >= 1; --j){
+					q = add(p[j], mul(q, xs[i]));
+					result[j - 1] = add(result[j - 1], mul(q, w[i]));
+				}
+			}
+			return result;
+		}
+		const int c = (l + r) / 2;
+		const vector<unsigned int> a = multiply(combine(tree, xs, w, 2 * v, l, c), tree[2 * v + 1]);
+		const vector<unsigned int> b = multiply(combine(tree, xs, w, 2 * v + 1, c, r), tree[2 * v]);
+		vector<unsigned int> result(max(a.size(), b.size()), 0);
+		for(size_t i = 0; i < a.size(); ++i){ result[i] = add(result[i], a[i]); }
+		for(size_t i = 0; i < b.size(); ++i){ result[i] = add(result[i], b[i]); }
+		return result;
+	}
+
+public:
+	/**
+	 *  @brief コンストラクタ
+	 *  @param[in] mod   法 (数論変換に適した奇素数、mod < 2^31)
+	 *  @param[in] root  法 mod での原始根
+	 */
+	PolynomialRing(unsigned int mod = 998244353, unsigned int root = 3) :
+		m_ntt(mod, root), m_mod(mod), m_inverses(), m_x(), m_y(), m_z()
+	{ }
+
+	/**
+	 *  @brief 法の取得
+	 *  @return 法
+	 */
+	unsigned int modulus() const { return m_mod; }
+
+	/**
+	 *  @brief 多項式の乗算
+	 *
+	 *  計算量は \f$ \mathcal{O}(n \log{n}) \f$ (n = |a|+|b|)。
+	 *
+	 *  @param[in] a  乗算する多項式
+	 *  @param[in] b  乗算する多項式
+	 *  @return    積 (大きさ |a|+|b|-1、どちらかが空なら空)
+	 */
+	vector<unsigned int> multiply(const vector<unsigned int> &a, const vector<unsigned int> &b){
+		return m_ntt.convolve(a, b);
+	}
+
+	/**
+	 *  @brief 逆元
+	 *
+	 *  \f$ fg \equiv 1 \pmod{x^n} \f$ となる g をNewton法で求める。
+	 *  1回の反復で長さ 2m の変換を5回行う。
+	 *  計算量は \f$ \mathcal{O}(n \log{n}) \f$。
+	 *
+	 *  @param[in] f  対象の冪級数 (f[0] != 0)
+	 *  @param[in] n  求める項数
+	 *  @return    \f$ f^{-1} \bmod x^n \f$
+	 */
+	vector<unsigned int> inverse(const vector<unsigned int> &f, int n){
+		assert(!f.empty() && f[0] != 0);
+		vector<unsigned int> g(1, m_ntt.inverse_of(f[0]));
+		g.reserve(n);
+		for(int m = 1; m < n; m <<= 1){
+			// g mod x^m から g mod x^{2m} を求める
+			m_x.assign(f.begin(), f.begin() + min<size_t>(f.size(), 2 * m));
+			m_y.assign(g.begin(), g.end());
+			forward_transform(m_x, 2 * m);
+			forward_transform(m_y, 2 * m);
+			pointwise(m_x, m_y, 2 * m);
+			inverse_transform(m_x, 2 * m);
+			// fg の x^m から x^{2m-1} までの係数だけが必要
+			fill(m_x.begin(), m_x.begin() + m, 0);
+			forward_transform(m_x, 2 * m);
+			pointwise(m_x, m_y, 2 * m);
+			inverse_transform(m_x, 2 * m);
+			g.resize(2 * m);
+			for(int i = m; i < 2 * m; ++i){ g[i] = sub(0, m_x[i]); }
+		}
+		g.resize(n);
+		return g;
+	}
+
+	/**
+	 *  @brief 冪級数の除算
+	 *
+	 *  計算量は \f$ \mathcal{O}(n \log{n}) \f$。
+	 *
+	 *  @param[in] f  被除数
+	 *  @param[in] g  除数 (g[0] != 0)
+	 *  @param[in] n  求める項数
+	 *  @return    \f$ f / g \bmod x^n \f$
+	 */
+	vector<unsigned int> divide(const vector<unsigned int> &f, const vector<unsigned int> &g, int n){
+		vector<unsigned int> h = multiply(
+			vector<unsigned int>(f.begin(), f.begin() + min<size_t>(f.size(), n)), inverse(g, n));
+		h.resize(n);
+		return h;
+	}
+
+	/**
+	 *  @brief 多項式の除算
+	 *
+	 *  係数を逆順にした多項式の冪級数としての除算によって商を求める。
+	 *  計算量は \f$ \mathcal{O}(n \log{n}) \f$ (n = |a|)。
+	 *
+	 *  @param[in] a  被除数
+	 *  @param[in] b  除数 (最高次の係数が0でないこと)
+	 *  @return    商と余り (余りの大きさは |b|-1)
+	 */
+	pair< vector<unsigned int>, vector<unsigned int> > divide(
+		const vector<unsigned int> &a, const vector<unsigned int> &b)
+	{
+		assert(!b.empty() && b.back() != 0);
+		const int n = a.size(), m = b.size();
+		if(n < m){
+			vector<unsigned int> r(a);
+			r.resize(m - 1, 0);
+			return make_pair(vector<unsigned int>(), r);
+		}
+		const int k = n - m + 1;
+		const vector<unsigned int> ra(a.rbegin(), a.rbegin() + k), rb(b.rbegin(), b.rend());
+		vector<unsigned int> q = divide(ra, rb, k);
+		reverse(q.begin(), q.end());
+		const vector<unsigned int> bq = multiply(b, q);
+		vector<unsigned int> r(m - 1);
+		for(int i = 0; i < m - 1; ++i){ r[i] = sub(a[i], bq[i]); }
+		return make_pair(q, r);
+	}
+
+	/**
+	 *  @brief 対数関数
+	 *
+	 *  \f$ \log f = \int f' / f \f$ により求める。
+	 *  計算量は \f$ \mathcal{O}(n \log{n}) \f$。
+	 *
+	 *  @param[in] f  対象の冪級数 (f[0] == 1)
+	 *  @param[in] n  求める項数
+	 *  @return    \f$ \log f \bmod x^n \f$
+	 */
+	vector<unsigned int> log(const vector<unsigned int> &f, int n){
+		assert(!f.empty() && f[0] == 1);
+		if(n <= 1){ return vector<unsigned int>(n, 0); }
+		prepare_inverses(n);
+		vector<unsigned int> d(min<size_t>(f.size(), n) - 1);
+		for(size_t i = 0; i < d.size(); ++i){ d[i] = mul(f[i + 1], i + 1); }
+		vector<unsigned int> q = multiply(d, inverse(f, n - 1));
+		q.resize(n - 1);
+		vector<unsigned int> g(n, 0);
+		for(int i = 1; i < n; ++i){ g[i] = mul(q[i - 1], m_inverses[i]); }
+		return g;
+	}
+
+	/**
+	 *  @brief 指数関数
+	 *
+	 *  \f$ g = \exp f \bmod x^m \f$ と \f$ g^{-1} \bmod x^{m/2} \f$ を同時に
+	 *  Newton法で倍々に更新する。
+	 *  1回の反復で長さ m および 2m の変換をあわせて8回程度行う。
+	 *  計算量は \f$ \mathcal{O}(n \log{n}) \f$。
+	 *
+	 *  @param[in] f  対象の冪級数 (f[0] == 0)
+	 *  @param[in] n  求める項数
+	 *  @return    \f$ \exp f \bmod x^n \f$
+	 */
+	vector<unsigned int> exp(const vector<unsigned int> &f, int n){
+		assert(f.empty() || f[0] == 0);
+		if(n <= 0){ return vector<unsigned int>(); }
+		prepare_inverses(2 * n);
+		// b = exp(f) mod x^m, c = b^{-1} mod x^{m/2}, z = c の長さ m の変換
+		vector<unsigned int> b(1, 1), c(1, 1), z(2, 1);
+		b.push_back(f.size() > 1 ? f[1] : 0);
+		b.reserve(2 * n);
+		c.reserve(n);
+		for(int m = 2; m < n; m <<= 1){
+			// y = b の長さ 2m の変換。前半 m 要素は長さ m の変換に等しい
+			m_y.assign(b.begin(), b.end());
+			forward_transform(m_y, 2 * m);
+			// c を b^{-1} mod x^m に更新する
+			m_z.assign(m, 0);
+			for(int i = 0; i < m; ++i){ m_z[i] = mul(m_y[i], z[i]); }
+			inverse_transform(m_z, m);
+			fill(m_z.begin(), m_z.begin() + m / 2, 0);
+			forward_transform(m_z, m);
+			pointwise(m_z, z, m);
+			inverse_transform(m_z, m);
+			for(int i = m / 2; i < m; ++i){ c.push_back(sub(0, m_z[i])); }
+			z.assign(c.begin(), c.end());
+			forward_transform(z, 2 * m);
+			// x = (b f_m' - b') / b の積分 (f_m = f mod x^m) に f の上位の係数を加えて f - log b を得る
+			m_x.assign(m, 0);
+			for(int i = 1; i < m && i < static_cast<int>(f.size()); ++i){
+				m_x[i - 1] = mul(f[i], i);
+			}
+			forward_transform(m_x, m);
+			pointwise(m_x, m_y, m);
+			inverse_transform(m_x, m);
+			for(int i = 1; i < m; ++i){ m_x[i - 1] = sub(m_x[i - 1], mul(b[i], i)); }
+			// 巡回畳み込みで折り返された上位の係数を本来の位置に戻す
+			m_x.resize(2 * m, 0);
+			for(int i = 0; i < m - 1; ++i){
+				m_x[m + i] = m_x[i];
+				m_x[i] = 0;
+			}
+			forward_transform(m_x, 2 * m);
+			pointwise(m_x, z, 2 * m);
+			inverse_transform(m_x, 2 * m);
+			for(int i = 2 * m - 1; i >= m; --i){
+				m_x[i] = mul(m_x[i - 1], m_inverses[i]);
+				if(i < static_cast<int>(f.size())){ m_x[i] = add(m_x[i], f[i]); }
+			}
+			// b に b (f - log b) の x^m から x^{2m-1} までの係数を加える
+			fill(m_x.begin(), m_x.begin() + m, 0);
+			forward_transform(m_x, 2 * m);
+			pointwise(m_x, m_y, 2 * m);
+			inverse_transform(m_x, 2 * m);
+			b.insert(b.end(), m_x.begin() + m, m_x.end());
+		}
+		b.resize(n);
+		return b;
+	}
+
+	/**
+	 *  @brief 平方根
+	 *
+	 *  最低次の項の平方根を求めたのち、\f$ g \leftarrow (g + f / g) / 2 \f$ の
+	 *  Newton法で倍々に精度を上げる。
+	 *  計算量は \f$ \mathcal{O}(n \log{n}) \f$。
+	 *
+	 *  @param[in] f  対象の冪級数
+	 *  @param[in] n  求める項数
+	 *  @return    \f$ g^2 \equiv f \pmod{x^n} \f$ となる g。存在しなければ空のベクタ。
+	 */
+	vector<unsigned int> sqrt(const vector<unsigned int> &f, int n){
+		size_t d = 0;
+		while(d < f.size() && f[d] == 0){ ++d; }
+		// f が x^n で割り切れるときは 0 が解となる
+		if(d == f.size() || static_cast<ll>(d) >= n){ return vector<unsigned int>(n, 0); }
+		const ll s = (d % 2 == 0 ? sqrt_mod(f[d]) : -1);
+		if(s < 0){ return vector<unsigned int>(); }
+		const int k = n - d / 2;
+		const vector<unsigned int> h(f.begin() + d, f.begin() + min(f.size(), d + k));
+		const unsigned int inv2 = (m_mod + 1) / 2;
+		vector<unsigned int> g(1, s);
+		for(int m = 1; m < k; m <<= 1){
+			const vector<unsigned int> t = divide(h, g, 2 * m);
+			g.resize(2 * m, 0);
+			for(int i = 0; i < 2 * m; ++i){ g[i] = mul(add(g[i], t[i]), inv2); }
+		}
+		g.resize(k);
+		g.insert(g.begin(), d / 2, 0);
+		return g;
+	}
+
+	/**
+	 *  @brief 多点評価
+	 *
+	 *  部分積木を構築し、根から順に剰余をとって各点での値を求める。
+	 *  計算量は \f$ \mathcal{O}(n \log^2{n} + |f| \log{|f|}) \f$ (n = |xs|)。
+	 *
+	 *  @param[in] f   評価する多項式
+	 *  @param[in] xs  評価する点の列
+	 *  @return    各点での f の値
+	 */
+	vector<unsigned int> evaluate(const vector<unsigned int> &f, const vector<unsigned int> &xs){
+		const int n = xs.size();
+		vector<unsigned int> ys(n);
+		if(n == 0){ return ys; }
+		vector< vector<unsigned int> > tree(4 * ((n + LEAF - 1) / LEAF));
+		build(tree, xs, 1, 0, n);
+		const vector<unsigned int> r = (f.size() >= tree[1].size() ? divide(f, tree[1]).second : f);
+		evaluate(tree, xs, r, 1, 0, n, ys);
+		return ys;
+	}
+
+	/**
+	 *  @brief 補間
+	 *
+	 *  \f$ M(x) = \prod_i (x - x_i) \f$ として、
+	 *  \f$ \sum_i y_i / M'(x_i) \prod_{j \neq i} (x - x_j) \f$ を部分積木に沿って求める。
+	 *  計算量は \f$ \mathcal{O}(n \log^2{n}) \f$。
+	 *
+	 *  @param[in] xs  点の列 (互いに異なること)
+	 *  @param[in] ys  各点での値
+	 *  @return    すべての点を通る |xs|-1 次以下の多項式 (大きさ |xs|)
+	 */
+	vector<unsigned int> interpolate(const vector<unsigned int> &xs, const vector<unsigned int> &ys){
+		assert(xs.size() == ys.size());
+		const int n = xs.size();
+		if(n == 0){ return vector<unsigned int>(); }
+		vector< vector<unsigned int> > tree(4 * ((n + LEAF - 1) / LEAF));
+		build(tree, xs, 1, 0, n);
+		vector<unsigned int> d(n);
+		for(int i = 0; i < n; ++i){ d[i] = mul(tree[1][i + 1], i + 1); }
+		vector<unsigned int> w(n);
+		evaluate(tree, xs, d, 1, 0, n, w);
+		for(int i = 0; i < n; ++i){ w[i] = mul(ys[i], m_ntt.inverse_of(w[i])); }
+		vector<unsigned int> p = combine(tree, xs, w, 1, 0, n);
+		p.resize(n, 0);
+		return p;
+	}
+
+};
+
+/**
+ *  @}
+ */
+
+}
+}
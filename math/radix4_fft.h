@@ -0,0 +1,337 @@
+/**
+ *  @file math/radix4_fft.h
+ */
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <cstring>
+#include <cmath>
+#include <cassert>
+#include "common/header.h"
+
+namespace libcomp {
+namespace math {
+
+/**
+ *  @defgroup radix4_fft Radix-4 FFT
+ *  @ingroup  math
+ *  @{
+ */
+
+/**
+ *  @brief 実部・虚部分離形式の基数4高速フーリエ変換
+ *
+ *  複素数列を実部と虚部の2本の配列で受け取り、基数4のバタフライで変換する。
+ *  変換の大きさが4のべき乗でない場合は最後の1段のみ基数2で処理する。
+ *  GCC/Clang ではベクトル拡張を用いて複数要素ずつ処理する。
+ *  AVX が有効なら4要素、そうでなければ2要素単位となり、
+ *  -mavx2 -mfma などを指定してコンパイルすれば AVX2/FMA 命令が使われる。
+ *  4096 要素以下の段はブロックごとにまとめて処理し、キャッシュ上で完結させる。
+ *  符号と正規化の規約は FFTPlan と同じ。
+ *  構築の計算量は \f$ \mathcal{O}(n) \f$。
+ */
+class Radix4FFTPlan {
+
+private:
+	static const int BLOCK = 1 << 12;
+
+	int m_size;
+	int m_log;
+	vector<int> m_rev;
+	vector<double> m_twiddles;
+	vector<size_t> m_offsets;
+	mutable vector<double> m_re, m_im;
+
+#if defined(__AVX__)
+	typedef double vector_type __attribute__((vector_size(32)));
+#elif defined(__GNUC__)
+	typedef double vector_type __attribute__((vector_size(16)));
+#endif
+
+	template <typename V>
+	static V load(const double *p){
+		V v;
+		memcpy(&v, p, sizeof(v));
+		return v;
+	}
+
+	template <typename V>
+	static void store(double *p, const V &v){ memcpy(p, &v, sizeof(v)); }
+
+	// 長さ L = 4q の区間に対する周波数間引きの基数4バタフライ (j から V の幅だけ)
+	template <typename V>
+	static void forward_butterfly(
+		double *re, double *im, int q, int j, const double *tw)
+	{
+		const V a0r = load<V>(re + j),         a0i = load<V>(im + j);
+		const V a1r = load<V>(re + j + q),     a1i = load<V>(im + j + q);
+		const V a2r = load<V>(re + j + 2 * q), a2i = load<V>(im + j + 2 * q);
+		const V a3r = load<V>(re + j + 3 * q), a3i = load<V>(im + j + 3 * q);
+		const V t0r = a0r + a2r, t0i = a0i + a2i;
+		const V t1r = a0r - a2r, t1i = a0i - a2i;
+		const V t2r = a1r + a3r, t2i = a1i + a3i;
+		const V dr = a1r - a3r, di = a1i - a3i;
+		const V w1r = load<V>(tw + j),         w1i = load<V>(tw + q + j);
+		const V w2r = load<V>(tw + 2 * q + j), w2i = load<V>(tw + 3 * q + j);
+		const V w3r = load<V>(tw + 4 * q + j), w3i = load<V>(tw + 5 * q + j);
+		const V x2r = t0r - t2r, x2i = t0i - t2i;
+		const V x1r = t1r - di,  x1i = t1i + dr;
+		const V x3r = t1r + di,  x3i = t1i - dr;
+		store(re + j, t0r + t2r);
+		store(im + j, t0i + t2i);
+		store(re + j + q, x2r * w2r - x2i * w2i);
+		store(im + j + q, x2r * w2i + x2i * w2r);
+		store(re + j + 2 * q, x1r * w1r - x1i * w1i);
+		store(im + j + 2 * q, x1r * w1i + x1i * w1r);
+		store(re + j + 3 * q, x3r * w3r - x3i * w3i);
+		store(im + j + 3 * q, x3r * w3i + x3i * w3r);
+	}
+
+	// forward_butterfly の逆 (時間間引き、共役な回転因子)
+	template <typename V>
+	static void inverse_butterfly(
+		double *re, double *im, int q, int j, const double *tw)
+	{
+		const V w1r = load<V>(tw + j),         w1i = load<V>(tw + q + j);
+		const V w2r = load<V>(tw + 2 * q + j), w2i = load<V>(tw + 3 * q + j);
+		const V w3r = load<V>(tw + 4 * q + j), w3i = load<V>(tw + 5 * q + j);
+		const V b0r = load<V>(re + j),         b0i = load<V>(im + j);
+		const V x2r = load<V>(re + j + q),     x2i = load<V>(im + j + q);
+		const V x1r = load<V>(re + j + 2 * q), x1i = load<V>(im + j + 2 * q);
+		const V x3r = load<V>(re + j + 3 * q), x3i = load<V>(im + j + 3 * q);
+		const V c2r = x2r * w2r + x2i * w2i, c2i = x2i * w2r - x2r * w2i;
+		const V c1r = x1r * w1r + x1i * w1i, c1i = x1i * w1r - x1r * w1i;
+		const V c3r = x3r * w3r + x3i * w3i, c3i = x3i * w3r - x3r * w3i;
+		const V sr = b0r + c2r, si = b0i + c2i;
+		const V dr = b0r - c2r, di = b0i - c2i;
+		const V pr = c1r + c3r, pi = c1i + c3i;
+		const V mr = c1r - c3r, mi = c1i - c3i;
+		store(re + j, sr + pr);
+		store(im + j, si + pi);
+		store(re + j + 2 * q, sr - pr);
+		store(im + j + 2 * q, si - pi);
+		store(re + j + q, dr + mi);
+		store(im + j + q, di - mr);
+		store(re + j + 3 * q, dr - mi);
+		store(im + j + 3 * q, di + mr);
+	}
+
+	template <bool INVERSE>
+	void radix4_stage(double *re, double *im, int total, int L) const {
+		const int q = L >> 2;
+		const double *tw = &m_twiddles[m_offsets[__builtin_ctz(L)]];
+		for(int base = 0; base < total; base += L){
+			double *r = re + base, *i = im + base;
+			int j = 0;
+#ifdef __GNUC__
+			const int width = sizeof(vector_type) / sizeof(double);
+			for(; j + width <= q; j += width){
+				if(INVERSE){
+					inverse_butterfly<vector_type>(r, i, q, j, tw);
+				}else{
+					forward_butterfly<vector_type>(r, i, q, j, tw);
+				}
+			}
+#endif
+			for(; j < q; ++j){
+				if(INVERSE){
+					inverse_butterfly<double>(r, i, q, j, tw);
+				}else{
+					forward_butterfly<double>(r, i, q, j, tw);
+				}
+			}
+		}
+	}
+
+	static void radix2_stage(double *re, double *im, int total){
+		for(int j = 0; j < total; j += 2){
+			const double xr = re[j], xi = im[j], yr = re[j + 1], yi = im[j + 1];
+			re[j] = xr + yr;
+			im[j] = xi + yi;
+			re[j + 1] = xr - yr;
+			im[j + 1] = xi - yi;
+		}
+	}
+
+	// 長さ total の区間に対して長さ L 以下の段をすべて行う
+	void forward_stages(double *re, double *im, int total, int L) const {
+		for(; L >= 4; L >>= 2){ radix4_stage<false>(re, im, total, L); }
+		if(L == 2){ radix2_stage(re, im, total); }
+	}
+
+	void inverse_stages(double *re, double *im, int total, int L) const {
+		int k = (__builtin_ctz(L) & 1) ? 2 : 1;
+		if(k == 2){ radix2_stage(re, im, total); }
+		for(k <<= 2; k <= L; k <<= 2){ radix4_stage<true>(re, im, total, k); }
+	}
+
+	// ビット反転置換。添字を上位・中位・下位 TILE ビットに分け、
+	// 中位ビットが互いに反転した関係にある 2^TILE x 2^TILE のタイルの組ごとに入れ替える。
+	void permute(double *x) const {
+		const int TILE = 4, T = 1 << TILE;
+		if(m_log < 2 * TILE){
+			for(int i = 0; i < m_size; ++i){
+				if(i < m_rev[i]){ swap(x[i], x[m_rev[i]]); }
+			}
+			return;
+		}
+		const int shift = m_log - TILE, middle = 1 << (m_log - 2 * TILE);
+		int rev[T];
+		for(int i = 0; i < T; ++i){ rev[i] = m_rev[i] >> shift; }
+		double a[T * T], b[T * T];
+		for(int m = 0; m < middle; ++m){
+			const int mr = m_rev[m] >> (2 * TILE);
+			if(mr < m){ continue; }
+			double *p = x + (m << TILE), *q = x + (mr << TILE);
+			for(int h = 0; h < T; ++h){
+				memcpy(a + h * T, p + (h << shift), sizeof(double) * T);
+				memcpy(b + h * T, q + (h << shift), sizeof(double) * T);
+			}
+			for(int h = 0; h < T; ++h){
+				double *pd = p + (h << shift), *qd = q + (h << shift);
+				for(int l = 0; l < T; ++l){
+					pd[l] = b[rev[l] * T + rev[h]];
+					qd[l] = a[rev[l] * T + rev[h]];
+				}
+			}
+		}
+	}
+
+public:
+	/**
+	 *  @brief コンストラクタ
+	 *  @param[in] n  変換の大きさ (2のべき乗であること)
+	 */
+	explicit Radix4FFTPlan(int n) :
+		m_size(n), m_log(0), m_rev(n), m_twiddles(), m_offsets(), m_re(), m_im()
+	{
+		assert(n > 0 && (n & (n - 1)) == 0);
+		while((1 << m_log) < n){ ++m_log; }
+		for(int i = 1; i < n; ++i){
+			m_rev[i] = (m_rev[i >> 1] >> 1) | ((i & 1) << (m_log - 1));
+		}
+		m_offsets.assign(m_log + 1, 0);
+		for(int L = n; L >= 4; L >>= 2){
+			const int q = L >> 2;
+			const size_t offset = m_twiddles.size();
+			m_offsets[__builtin_ctz(L)] = offset;
+			m_twiddles.resize(offset + 6 * q);
+			double *tw = &m_twiddles[offset];
+			for(int j = 0; j < q; ++j){
+				for(int k = 1; k <= 3; ++k){
+					const double theta = 2.0 * M_PI * k * j / L;
+					tw[(2 * k - 2) * q + j] = cos(theta);
+					tw[(2 * k - 1) * q + j] = sin(theta);
+				}
+			}
+		}
+	}
+
+	/**
+	 *  @brief 変換の大きさの取得
+	 *  @return 変換の大きさ
+	 */
+	int size() const { return m_size; }
+
+	/**
+	 *  @brief ビット反転順への変換
+	 *
+	 *  自然な順序の列を変換し、結果をビット反転した順序で出力する。
+	 *  各点ごとの積をとって inverse_from_bit_reversed で戻す場合は並べ替えが不要になる。
+	 *  計算量は \f$ \mathcal{O}(n \log{n}) \f$。
+	 *
+	 *  @param[in,out] re  実部 (大きさn)
+	 *  @param[in,out] im  虚部 (大きさn)
+	 */
+	void forward_to_bit_reversed(double *re, double *im) const {
+		int L = m_size;
+		for(; L > BLOCK; L >>= 2){ radix4_stage<false>(re, im, m_size, L); }
+		for(int base = 0; base < m_size; base += L){
+			forward_stages(re + base, im + base, L, L);
+		}
+	}
+
+	/**
+	 *  @brief ビット反転順からの逆変換
+	 *
+	 *  forward_to_bit_reversed の逆変換。1/n 倍の正規化は行わない。
+	 *  計算量は \f$ \mathcal{O}(n \log{n}) \f$。
+	 *
+	 *  @param[in,out] re  実部 (大きさn)
+	 *  @param[in,out] im  虚部 (大きさn)
+	 */
+	void inverse_from_bit_reversed(double *re, double *im) const {
+		int L = m_size;
+		while(L > BLOCK){ L >>= 2; }
+		for(int base = 0; base < m_size; base += L){
+			inverse_stages(re + base, im + base, L, L);
+		}
+		for(L <<= 2; L <= m_size; L <<= 2){ radix4_stage<true>(re, im, m_size, L); }
+	}
+
+	/**
+	 *  @brief 複素数列の変換
+	 *
+	 *  計算量は \f$ \mathcal{O}(n \log{n}) \f$。
+	 *
+	 *  @param[in,out] re       実部 (大きさn)。結果で上書きされる。
+	 *  @param[in,out] im       虚部 (大きさn)。結果で上書きされる。
+	 *  @param[in]     inverse  逆変換を行う場合にtrueを指定する
+	 */
+	void transform(double *re, double *im, bool inverse = false) const {
+		if(!inverse){
+			forward_to_bit_reversed(re, im);
+			permute(re);
+			permute(im);
+			return;
+		}
+		permute(re);
+		permute(im);
+		inverse_from_bit_reversed(re, im);
+		const double r = 1.0 / m_size;
+		for(int i = 0; i < m_size; ++i){
+			re[i] *= r;
+			im[i] *= r;
+		}
+	}
+
+	/**
+	 *  @brief 実数列の畳み込み
+	 *
+	 *  a を実部、b を虚部に詰めた列を変換して2乗し、逆変換の虚部の半分として積を得る。
+	 *  並べ替えを行わないため、大きさnの変換2回分で計算できる。
+	 *  作業領域は呼び出し間で再利用されるため、
+	 *  同じ計画に対して複数のスレッドから同時に呼び出してはならない。
+	 *  計算量は \f$ \mathcal{O}(n \log{n}) \f$。
+	 *
+	 *  @param[in] a  1つ目の列
+	 *  @param[in] b  2つ目の列 (|a|+|b|-1 <= n であること)
+	 *  @return    a と b の畳み込み (大きさ |a|+|b|-1、どちらかが空なら空)
+	 */
+	vector<double> convolve(const vector<double> &a, const vector<double> &b) const {
+		if(a.empty() || b.empty()){ return vector<double>(); }
+		const size_t size = a.size() + b.size() - 1;
+		assert(size <= static_cast<size_t>(m_size));
+		m_re.assign(m_size, 0.0);
+		m_im.assign(m_size, 0.0);
+		copy(a.begin(), a.end(), m_re.begin());
+		copy(b.begin(), b.end(), m_im.begin());
+		forward_to_bit_reversed(m_re.data(), m_im.data());
+		const double r = 0.5 / m_size;
+		for(int i = 0; i < m_size; ++i){
+			const double x = m_re[i], y = m_im[i];
+			m_re[i] = (x * x - y * y) * r;
+			m_im[i] = 2.0 * x * y * r;
+		}
+		inverse_from_bit_reversed(m_re.data(), m_im.data());
+		return vector<double>(m_im.begin(), m_im.begin() + size);
+	}
+
+};
+
+/**
+ *  @}
+ */
+
+}
+}
@@ -0,0 +1,261 @@
+/**
+ *  @file math/sparse_matrix.h
+ */
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include "common/header.h"
+#include "misc/thread_pool.h"
+
+namespace libcomp {
+namespace math {
+
+/**
+ *  @defgroup sparse_matrix Sparse matrix
+ *  @ingroup  math
+ *  @{
+ */
+
+/**
+ *  @brief CSR形式の疎行列
+ *
+ *  非零要素を行ごとにまとめ、列番号と値を1本ずつの配列に格納する
+ *  (Compressed Sparse Row)。
+ *  メモリ使用量は \f$ \mathcal{O}(N + \mathit{nnz}) \f$。
+ *  構築後は要素の追加・削除はできない。
+ *
+ *  @tparam T  要素の表現に用いる型
+ */
+template <typename T>
+class SparseMatrix {
+
+public:
+	/**
+	 *  @brief 構築に用いる非零要素
+	 */
+	struct Entry {
+		/// 行番号
+		int row;
+		/// 列番号
+		int column;
+		/// 値
+		T value;
+
+		/// コンストラクタ
+		Entry(int row = 0, int column = 0, const T &value = T()) :
+			row(row), column(column), value(value)
+		{ }
+	};
+
+private:
+	int N, M;
+	vector<int> m_row_ptr;
+	vector<int> m_columns;
+	vector<T> m_values;
+	mutable vector<T> m_workspace;
+
+	/*
+	 *  行を非零要素数がほぼ等しい k 個の区間に分割した境界を返す。
+	 */
+	vector<int> partition(int k) const {
+		vector<int> bounds(k + 1, N);
+		bounds[0] = 0;
+		const ll nnz = m_values.size();
+		for(int i = 1; i < k; ++i){
+			const int target = static_cast<int>(nnz * i / k);
+			bounds[i] = lower_bound(m_row_ptr.begin(), m_row_ptr.end(), target) - m_row_ptr.begin();
+			bounds[i] = max(bounds[i - 1], min(bounds[i], N));
+		}
+		return bounds;
+	}
+
+	void multiply_rows(const T *x, T *y, int r0, int r1) const {
+		for(int i = r0; i < r1; ++i){
+			T sum = T();
+			for(int k = m_row_ptr[i]; k < m_row_ptr[i + 1]; ++k){
+				sum += m_values[k] * x[m_columns[k]];
+			}
+			y[i] = sum;
+		}
+	}
+
+	void scatter_rows(const T *x, T *y, int r0, int r1) const {
+		for(int i = r0; i < r1; ++i){
+			const T xi = x[i];
+			for(int k = m_row_ptr[i]; k < m_row_ptr[i + 1]; ++k){
+				y[m_columns[k]] += m_values[k] * xi;
+			}
+		}
+	}
+
+public:
+	/**
+	 *  @brief コンストラクタ
+	 *
+	 *  非零要素の列から行列を構築する。
+	 *  同じ位置の要素が複数ある場合はそれらの和を値とする。
+	 *  計算量は \f$ \mathcal{O}(N + \mathit{nnz} \log{\mathit{nnz}}) \f$。
+	 *
+	 *  @param[in] N        行列の行数
+	 *  @param[in] M        行列の列数
+	 *  @param[in] entries  非零要素の列
+	 */
+	SparseMatrix(int N, int M, const vector<Entry> &entries) :
+		N(N), M(M), m_row_ptr(N + 1), m_columns(), m_values(), m_workspace()
+	{
+		// 行番号による計数ソート
+		vector<int> count(N + 1);
+		for(size_t k = 0; k < entries.size(); ++k){
+			assert(0 <= entries[k].row && entries[k].row < N);
+			assert(0 <= entries[k].column && entries[k].column < M);
+			++count[entries[k].row + 1];
+		}
+		for(int i = 0; i < N; ++i){ count[i + 1] += count[i]; }
+		vector< pair<int, T> > sorted(entries.size());
+		vector<int> head(count.begin(), count.end() - 1);
+		for(size_t k = 0; k < entries.size(); ++k){
+			sorted[head[entries[k].row]++] = make_pair(entries[k].column, entries[k].value);
+		}
+		// 行ごとに列番号でソートし、重複を併合する
+		m_columns.reserve(entries.size());
+		m_values.reserve(entries.size());
+		for(int i = 0; i < N; ++i){
+			sort(sorted.begin() + count[i], sorted.begin() + count[i + 1],
+			     [](const pair<int, T> &a, const pair<int, T> &b){ return a.first < b.first; });
+			m_row_ptr[i] = m_columns.size();
+			for(int k = count[i]; k < count[i + 1]; ++k){
+				if(static_cast<int>(m_columns.size()) > m_row_ptr[i] &&
+				   m_columns.back() == sorted[k].first)
+				{
+					m_values.back() += sorted[k].second;
+				}else{
+					m_columns.push_back(sorted[k].first);
+					m_values.push_back(sorted[k].second);
+				}
+			}
+		}
+		m_row_ptr[N] = m_columns.size();
+	}
+
+	/**
+	 *  @brief 行列の行数の取得
+	 *  @return 行列の行数
+	 */
+	int rows() const { return N; }
+	/**
+	 *  @brief 行列の列数の取得
+	 *  @return 行列の列数
+	 */
+	int columns() const { return M; }
+	/**
+	 *  @brief 非零要素数の取得
+	 *  @return 格納されている要素数
+	 */
+	int nonzeros() const { return m_values.size(); }
+
+	/**
+	 *  @brief 行に含まれる要素の範囲の取得
+	 *
+	 *  i行目の要素は column_index(k), value(k) (row_begin(i) <= k < row_end(i)) で得られる。
+	 *
+	 *  @param[in] i  行番号
+	 *  @return    i行目の最初の要素の番号
+	 */
+	int row_begin(int i) const { return m_row_ptr[i]; }
+	/**
+	 *  @brief 行に含まれる要素の範囲の取得
+	 *  @param[in] i  行番号
+	 *  @return    i行目の最後の要素の次の番号
+	 */
+	int row_end(int i) const { return m_row_ptr[i + 1]; }
+	/**
+	 *  @brief 要素の列番号の取得
+	 *  @param[in] k  要素の番号
+	 *  @return    k番目の要素の列番号
+	 */
+	int column_index(int k) const { return m_columns[k]; }
+	/**
+	 *  @brief 要素の値の取得
+	 *  @param[in] k  要素の番号
+	 *  @return    k番目の要素の値
+	 */
+	const T &value(int k) const { return m_values[k]; }
+
+	/**
+	 *  @brief 行列とベクトルの積
+	 *
+	 *  \f$ y = Ax \f$ を計算する。
+	 *  poolを指定した場合は非零要素数が均等になるように行を分割して並列に計算する。
+	 *  計算量は \f$ \mathcal{O}(N + \mathit{nnz}) \f$。
+	 *
+	 *  @param[in]  x     乗算するベクトル (大きさM)
+	 *  @param[out] y     積の出力先 (大きさN、xとは異なる領域であること)
+	 *  @param[in]  pool  並列化に用いるスレッドプール (NULLなら逐次実行)
+	 */
+	void multiply(const vector<T> &x, vector<T> &y, misc::ThreadPool *pool = NULL) const {
+		assert(static_cast<int>(x.size()) == M && &x != &y);
+		y.resize(N);
+		if(!pool || pool->size() == 1){
+			multiply_rows(x.data(), y.data(), 0, N);
+			return;
+		}
+		const vector<int> bounds = partition(pool->size() * 4);
+		const T *px = x.data();
+		T *py = y.data();
+		pool->parallel_for(0, bounds.size() - 1, [&](int k){
+			multiply_rows(px, py, bounds[k], bounds[k + 1]);
+		});
+	}
+
+	/**
+	 *  @brief 転置行列とベクトルの積
+	 *
+	 *  \f$ y = A^{\mathrm{T}} x \f$ を転置行列を作らずに計算する。
+	 *  poolを指定した場合は行の区間ごとに作業領域へ部分和を求め、
+	 *  最後に列方向に分割して足し合わせる。
+	 *  作業領域は呼び出し間で再利用されるため、
+	 *  同じ行列に対して複数のスレッドから同時に呼び出してはならない。
+	 *  計算量は \f$ \mathcal{O}(N + M + \mathit{nnz}) \f$。
+	 *
+	 *  @param[in]  x     乗算するベクトル (大きさN)
+	 *  @param[out] y     積の出力先 (大きさM、xとは異なる領域であること)
+	 *  @param[in]  pool  並列化に用いるスレッドプール (NULLなら逐次実行)
+	 */
+	void multiply_transposed(
+		const vector<T> &x, vector<T> &y, misc::ThreadPool *pool = NULL) const
+	{
+		assert(static_cast<int>(x.size()) == N && &x != &y);
+		y.assign(M, T());
+		if(!pool || pool->size() == 1){
+			scatter_rows(x.data(), y.data(), 0, N);
+			return;
+		}
+		const int P = pool->size();
+		const vector<int> bounds = partition(P);
+		m_workspace.assign(static_cast<size_t>(P) * M, T());
+		const T *px = x.data();
+		T *py = y.data();
+		T *pw = m_workspace.data();
+		const int m = M;
+		pool->parallel_for(0, P, [&](int k){
+			scatter_rows(px, pw + static_cast<size_t>(k) * m, bounds[k], bounds[k + 1]);
+		});
+		const int BLOCK = 4096;
+		pool->parallel_for(0, (m + BLOCK - 1) / BLOCK, [&](int b){
+			const int j0 = b * BLOCK, j1 = min(j0 + BLOCK, m);
+			for(int k = 0; k < P; ++k){
+				const T *wk = pw + static_cast<size_t>(k) * m;
+				for(int j = j0; j < j1; ++j){ py[j] += wk[j]; }
+			}
+		});
+	}
+
+};
+
+/**
+ *  @}
+ */
+
+}
+}
@@ -0,0 +1,328 @@
+/**
+ *  @file math/static_matrix.h
+ */
+#pragma once
+#include <iostream>
+#include <utility>
+#include <initializer_list>
+#include "common/header.h"
+
+namespace libcomp {
+namespace math {
+
+/**
+ *  @defgroup static_matrix Static matrix
+ *  @ingroup  math
+ *  @{
+ */
+
+/**
+ *  @brief 固定サイズ行列
+ *
+ *  サイズをコンパイル時に決定する行列型。
+ *  要素は T 型の固定長配列として行優先で保持するため、
+ *  ヒープ領域を使わず、小さな行列はレジスタ上で扱われる。
+ *  行列積は添字列の展開によって完全に展開され、
+ *  すべての演算は定数式の中で使用できる。
+ *
+ *  @tparam T  要素の表現に用いる型
+ *  @tparam N  行列の行数
+ *  @tparam M  行列の列数
+ */
+template <typename T, int N, int M>
+class StaticMatrix {
+
+	template <typename U, int P, int Q> friend class StaticMatrix;
+
+private:
+	T m_data[N * M];
+
+	template <typename... Ts>
+	constexpr StaticMatrix(std::integral_constant<int, 0>, Ts... xs) :
+		m_data{ xs... }
+	{ }
+
+	template <size_t I, size_t J, int L, size_t... Ks>
+	static constexpr T dot(
+		const StaticMatrix<T, N, M> &a, const StaticMatrix<T, M, L> &b,
+		index_sequence<Ks...>)
+	{
+		const T terms[] = { (a.m_data[I * M + Ks] * b.m_data[Ks * L + J])... };
+		T sum = T();
+		for(int k = 0; k < M; ++k){ sum += terms[k]; }
+		return sum;
+	}
+
+	template <int L, size_t... Is>
+	static constexpr StaticMatrix<T, N, L> multiply(
+		const StaticMatrix<T, N, M> &a, const StaticMatrix<T, M, L> &b,
+		index_sequence<Is...>)
+	{
+		return StaticMatrix<T, N, L>(
+			std::integral_constant<int, 0>(),
+			dot<Is / L, Is % L, L>(a, b, make_index_sequence<M>())...);
+	}
+
+public:
+	/**
+	 *  @brief コンストラクタ
+	 *
+	 *  すべての要素を T() で初期化する。
+	 */
+	constexpr StaticMatrix() : m_data() { }
+
+	/**
+	 *  @brief コンストラクタ
+	 *
+	 *  要素を行優先で列挙した値で初期化する。
+	 *  足りない要素は T() で初期化される。
+	 *
+	 *  @param[in] values  要素の値の列 (N * M 個以下)
+	 */
+	constexpr StaticMatrix(initializer_list<T> values) : m_data() {
+		int k = 0;
+		for(const T *it = values.begin(); it != values.end() && k < N * M; ++it){
+			m_data[k++] = *it;
+		}
+	}
+
+	/**
+	 *  @brief 行列の行数の取得
+	 *  @return 行列の行数
+	 */
+	static constexpr int rows(){ return N; }
+	/**
+	 *  @brief 行列の列数の取得
+	 *  @return 行列の列数
+	 */
+	static constexpr int columns(){ return M; }
+
+	/**
+	 *  @brief 単位行列の生成
+	 *  @return N次の単位行列
+	 */
+	static constexpr StaticMatrix<T, N, M> identity(){
+		static_assert(N == M, "identity matrix must be square");
+		StaticMatrix<T, N, M> ret;
+		for(int i = 0; i < N; ++i){ ret.m_data[i * M + i] = T(1); }
+		return ret;
+	}
+
+	/**
+	 *  @brief 行列内の要素の取得
+	 *  @param[in] i  取得したい要素の行番号
+	 *  @param[in] j  取得したい要素の列番号
+	 *  @return    指定したインデックスに対応する要素への参照
+	 */
+	constexpr const T &operator()(int i, int j) const { return m_data[i * M + j]; }
+	/**
+	 *  @brief 行列内の要素の取得
+	 *  @param[in] i  取得したい要素の行番号
+	 *  @param[in] j  取得したい要素の列番号
+	 *  @return    指定したインデックスに対応する要素への参照
+	 */
+	constexpr T &operator()(int i, int j){ return m_data[i * M + j]; }
+
+	/**
+	 *  @brief 行列の符号を反転
+	 *  @return すべての要素の正負が入れ替えられた行列
+	 */
+	constexpr StaticMatrix<T, N, M> operator-() const {
+		StaticMatrix<T, N, M> ret;
+		for(int k = 0; k < N * M; ++k){ ret.m_data[k] = -m_data[k]; }
+		return ret;
+	}
+
+	/**
+	 *  @brief 行列とスカラの加算 + 代入
+	 *  @param[in] s  加算するスカラ
+	 *  @return    自身への参照
+	 */
+	constexpr StaticMatrix<T, N, M> &operator+=(const T &s){
+		for(int k = 0; k < N * M; ++k){ m_data[k] += s; }
+		return *this;
+	}
+	/**
+	 *  @brief 行列とスカラの減算 + 代入
+	 *  @param[in] s  減算するスカラ
+	 *  @return    自身への参照
+	 */
+	constexpr StaticMatrix<T, N, M> &operator-=(const T &s){
+		for(int k = 0; k < N * M; ++k){ m_data[k] -= s; }
+		return *this;
+	}
+	/**
+	 *  @brief 行列とスカラの乗算 + 代入
+	 *  @param[in] s  乗算するスカラ
+	 *  @return    自身への参照
+	 */
+	constexpr StaticMatrix<T, N, M> &operator*=(const T &s){
+		for(int k = 0; k < N * M; ++k){ m_data[k] *= s; }
+		return *this;
+	}
+	/**
+	 *  @brief 行列とスカラの除算 + 代入
+	 *  @param[in] s  除算するスカラ
+	 *  @return    自身への参照
+	 */
+	constexpr StaticMatrix<T, N, M> &operator/=(const T &s){
+		for(int k = 0; k < N * M; ++k){ m_data[k] /= s; }
+		return *this;
+	}
+	/**
+	 *  @brief 行列とスカラの剰余 + 代入
+	 *  @param[in] s  剰余を取るスカラ
+	 *  @return    自身への参照
+	 */
+	constexpr StaticMatrix<T, N, M> &operator%=(const T &s){
+		for(int k = 0; k < N * M; ++k){ m_data[k] %= s; }
+		return *this;
+	}
+	/**
+	 *  @brief 行列と行列の加算 + 代入
+	 *  @param[in] m  加算する行列
+	 *  @return    自身への参照
+	 */
+	constexpr StaticMatrix<T, N, M> &operator+=(const StaticMatrix<T, N, M> &m){
+		for(int k = 0; k < N * M; ++k){ m_data[k] += m.m_data[k]; }
+		return *this;
+	}
+	/**
+	 *  @brief 行列と行列の減算 + 代入
+	 *  @param[in] m  減算する行列
+	 *  @return    自身への参照
+	 */
+	constexpr StaticMatrix<T, N, M> &operator-=(const StaticMatrix<T, N, M> &m){
+		for(int k = 0; k < N * M; ++k){ m_data[k] -= m.m_data[k]; }
+		return *this;
+	}
+
+	/**
+	 *  @brief 行列とスカラの加算
+	 *  @param[in] s  加算するスカラ
+	 *  @return    すべての要素にsを加算した行列
+	 */
+	constexpr StaticMatrix<T, N, M> operator+(const T &s) const {
+		StaticMatrix<T, N, M> ret(*this);
+		return ret += s;
+	}
+	/**
+	 *  @brief 行列とスカラの減算
+	 *  @param[in] s  減算するスカラ
+	 *  @return    すべての要素にsを減算した行列
+	 */
+	constexpr StaticMatrix<T, N, M> operator-(const T &s) const {
+		StaticMatrix<T, N, M> ret(*this);
+		return ret -= s;
+	}
+	/**
+	 *  @brief 行列とスカラの乗算
+	 *  @param[in] s  乗算するスカラ
+	 *  @return    すべての要素にsを乗算した行列
+	 */
+	constexpr StaticMatrix<T, N, M> operator*(const T &s) const {
+		StaticMatrix<T, N, M> ret(*this);
+		return ret *= s;
+	}
+	/**
+	 *  @brief 行列とスカラの除算
+	 *  @param[in] s  除算するスカラ
+	 *  @return    すべての要素にsを除算した行列
+	 */
+	constexpr StaticMatrix<T, N, M> operator/(const T &s) const {
+		StaticMatrix<T, N, M> ret(*this);
+		return ret /= s;
+	}
+	/**
+	 *  @brief 行列とスカラの剰余
+	 *  @param[in] s  剰余を取るスカラ
+	 *  @return    すべての要素にsとの剰余をとった行列
+	 */
+	constexpr StaticMatrix<T, N, M> operator%(const T &s) const {
+		StaticMatrix<T, N, M> ret(*this);
+		return ret %= s;
+	}
+	/**
+	 *  @brief 行列と行列の加算
+	 *  @param[in] m  加算する行列
+	 *  @return    (*this)とmの和
+	 */
+	constexpr StaticMatrix<T, N, M> operator+(const StaticMatrix<T, N, M> &m) const {
+		StaticMatrix<T, N, M> ret(*this);
+		return ret += m;
+	}
+	/**
+	 *  @brief 行列と行列の減算
+	 *  @param[in] m  減算する行列
+	 *  @return    (*this)とmの差
+	 */
+	constexpr StaticMatrix<T, N, M> operator-(const StaticMatrix<T, N, M> &m) const {
+		StaticMatrix<T, N, M> ret(*this);
+		return ret -= m;
+	}
+
+	/**
+	 *  @brief 行列と行列の乗算
+	 *
+	 *  出力の各要素を内積の和として展開し、ループを含まない形で計算する。
+	 *  計算量は \f$ \mathcal{O}(NML) \f$。
+	 *
+	 *  @param[in] m  乗算する行列
+	 *  @return    (*this)とmの積
+	 */
+	template <int L>
+	constexpr StaticMatrix<T, N, L> operator*(const StaticMatrix<T, M, L> &m) const {
+		return multiply(*this, m, make_index_sequence<N * L>());
+	}
+	/**
+	 *  @brief 行列と行列の乗算 + 代入
+	 *  @param[in] m  乗算する行列
+	 *  @return    自身への参照
+	 */
+	constexpr StaticMatrix<T, N, M> &operator*=(const StaticMatrix<T, M, M> &m){
+		return *this = *this * m;
+	}
+
+};
+
+/**
+ *  @brief 行列の累乗
+ *
+ *  正方行列mのe乗を繰り返し二乗法で求める。定数式の中で使用できる。
+ *  計算量は \f$ \mathcal{O}(N^3 \log{e}) \f$。
+ *
+ *  @param[in] m  底となる正方行列
+ *  @param[in] e  指数
+ *  @return    m の e 乗
+ */
+template <typename T, int N>
+constexpr StaticMatrix<T, N, N> pow(StaticMatrix<T, N, N> m, ull e){
+	StaticMatrix<T, N, N> result = StaticMatrix<T, N, N>::identity();
+	for(; e > 0; e >>= 1){
+		if(e & 1){ result = result * m; }
+		if(e > 1){ m = m * m; }
+	}
+	return result;
+}
+
+/**
+ *  @brief 行列の出力
+ *  @param[in,out] os  出力先ストリーム
+ *  @param[in]     m   出力する行列
+ *  @return        出力先ストリーム
+ */
+template <typename T, int N, int M>
+ostream &operator<<(ostream &os, const StaticMatrix<T, N, M> &m){
+	for(int i = 0; i < m.rows(); ++i){
+		for(int j = 0; j < m.columns(); ++j){ os << m(i, j) << "\t"; }
+		os << endl;
+	}
+	return os;
+}
+
+/**
+ *  @}
+ */
+
+}
+}
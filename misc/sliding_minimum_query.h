@@ -3,7 +3,11 @@
  */
 #pragma once
 #include <deque>
+#include <vector>
+#include <algorithm>
+#include <iterator>
 #include <functional>
+#include <cassert>
 #include "common/header.h"
 
 namespace libcomp {
@@ -88,6 +92,164 @@ public:
 
 };
 
+/**
+ *  @brief  リングバッファによるスライド最小値クエリ処理
+ *
+ *  SlidingMinimumQuery と同じ操作を、値とインデックスの組を
+ *  固定長の配列1本に格納したリングバッファ上で行う。
+ *  区間に同時に含まれる要素数の上限が既知の場合に用いる。
+ *
+ *  @tparam T  値の型
+ *  @tparam F  比較関数の型
+ */
+template < typename T, typename F = std::less<T> >
+class RingBufferSlidingMinimumQuery {
+
+private:
+	struct Entry {
+		T value;
+		int index;
+	};
+
+	vector<Entry> m_buffer;
+	size_t m_mask;
+	size_t m_head;
+	size_t m_tail;
+	F m_comparator;
+	int m_push_count;
+	int m_pop_count;
+
+public:
+	/**
+	 *  @brief コンストラクタ
+	 *
+	 *  要素が含まれない状態にクエリ処理器を初期化する。
+	 *
+	 *  @param[in] capacity    区間に同時に含まれる要素数の上限
+	 *  @param[in] comparator  比較関数
+	 */
+	explicit RingBufferSlidingMinimumQuery(
+		size_t capacity, const F &comparator = F()) :
+		m_buffer(), m_mask(0), m_head(0), m_tail(0),
+		m_comparator(comparator), m_push_count(0), m_pop_count(0)
+	{
+		size_t size = 1;
+		while(size < capacity){ size *= 2; }
+		m_buffer.resize(size);
+		m_mask = size - 1;
+	}
+
+	/**
+	 *  @brief 最小値クエリ
+	 *
+	 *  クエリ処理器が持っている区間の最小値を取得する。
+	 *  計算量は \f$ \mathcal{O}(1) \f$。
+	 *
+	 *  @return 区間に含まれている中で最小の値
+	 */
+	const T &query() const {
+		return m_buffer[m_head & m_mask].value;
+	}
+
+	/**
+	 *  @brief 区間の拡大
+	 *
+	 *  スライドしている区間の末尾に要素を追加する。
+	 *  計算量は \f$ \mathcal{O}(1) \f$ (amortized)。
+	 *
+	 *  @param[in] x  区間に新たに追加される値
+	 */
+	void push(const T &x){
+		assert(m_push_count - m_pop_count <= static_cast<int>(m_mask));
+		while(m_head != m_tail &&
+		      m_comparator(x, m_buffer[(m_tail - 1) & m_mask].value))
+		{
+			--m_tail;
+		}
+		Entry &e = m_buffer[m_tail & m_mask];
+		e.value = x;
+		e.index = m_push_count++;
+		++m_tail;
+	}
+
+	/**
+	 *  @brief 区間の縮小
+	 *
+	 *  スライドしている区間の先頭要素を取り除く。
+	 *  計算量は \f$ \mathcal{O}(1) \f$。
+	 */
+	void pop(){
+		if(m_buffer[m_head & m_mask].index == m_pop_count){ ++m_head; }
+		++m_pop_count;
+	}
+
+};
+
+/**
+ *  @brief 固定幅のスライド最小値の一括計算
+ *
+ *  van Herk/Gil-Werman法により、長さkの窓すべてについて最小値を求め、
+ *  out[i] に [first + i, first + i + k) の最小値を書き込む。
+ *  ブロック内の前方・後方累積最小値を求めたのち、
+ *  分岐を含まない要素ごとの結合ループで結果を得るため、
+ *  最後の結合はコンパイラの自動ベクトル化の対象となる。
+ *  計算量は \f$ \mathcal{O}(n) \f$ (比較回数は高々 3n 回)。
+ *
+ *  @param[in]  first       要素列の先頭を指すイテレータ
+ *  @param[in]  last        要素列の終端を指すイテレータ
+ *  @param[in]  k           窓の幅 (1以上)
+ *  @param[out] out         結果の出力先 (n - k + 1 要素)
+ *  @param[in]  comparator  比較関数
+ *  @return     出力した最後の要素の次を指すイテレータ
+ */
+template <typename RandomAccessIterator, typename OutputIterator, typename F>
+OutputIterator sliding_window_min(
+	RandomAccessIterator first, RandomAccessIterator last, int k,
+	OutputIterator out, F comparator)
+{
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+	assert(k >= 1);
+	const int n = static_cast<int>(distance(first, last));
+	if(n < k){ return out; }
+	vector<T> prefix(first, last), suffix(first, last);
+	for(int b = 0; b < n; b += k){
+		const int e = min(b + k, n);
+		for(int i = b + 1; i < e; ++i){
+			if(comparator(prefix[i - 1], prefix[i])){ prefix[i] = prefix[i - 1]; }
+		}
+		for(int i = e - 2; i >= b; --i){
+			if(comparator(suffix[i + 1], suffix[i])){ suffix[i] = suffix[i + 1]; }
+		}
+	}
+	const int m = n - k + 1;
+	const T *p = &prefix[k - 1];
+	T *s = &suffix[0];
+	for(int i = 0; i < m; ++i){
+		s[i] = comparator(p[i], s[i]) ? p[i] : s[i];
+	}
+	return copy(suffix.begin(), suffix.begin() + m, out);
+}
+
+/**
+ *  @brief 固定幅のスライド最小値の一括計算
+ *
+ *  比較関数に std::less を用いる sliding_window_min。
+ *
+ *  @param[in]  first  要素列の先頭を指すイテレータ
+ *  @param[in]  last   要素列の終端を指すイテレータ
+ *  @param[in]  k      窓の幅 (1以上)
+ *  @param[out] out    結果の出力先 (n - k + 1 要素)
+ *  @return     出力した最後の要素の次を指すイテレータ
+ */
+template <typename RandomAccessIterator, typename OutputIterator>
+OutputIterator sliding_window_min(
+	RandomAccessIterator first, RandomAccessIterator last, int k,
+	OutputIterator out)
+{
+	typedef typename iterator_traits<RandomAccessIterator>::value_type T;
+	return sliding_window_min(first, last, k, out, std::less<T>());
+}
+
 /**
  *  @}
  */
@@ -0,0 +1,143 @@
+/**
+ *  @file misc/thread_pool.h
+ */
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include "common/header.h"
+
+namespace libcomp {
+namespace misc {
+
+/**
+ *  @defgroup thread_pool Thread pool
+ *  @ingroup  misc
+ *  @{
+ */
+
+/**
+ *  @brief 固定数のワーカーによるスレッドプール
+ *
+ *  parallel_for によってインデックス範囲を動的に分配して並列に処理する。
+ *  呼び出したスレッド自身も処理に参加するため、
+ *  n スレッドのプールは n - 1 個のワーカースレッドを持つ。
+ *  parallel_for を複数のスレッドから同時に呼び出してはならない。
+ */
+class ThreadPool {
+
+private:
+	vector<thread> m_workers;
+	mutex m_mutex;
+	condition_variable m_start;
+	condition_variable m_finish;
+	function<void(int)> m_task;
+	atomic<int> m_next;
+	int m_end;
+	int m_active;
+	ull m_generation;
+	bool m_stop;
+
+	ThreadPool(const ThreadPool &);
+	ThreadPool &operator=(const ThreadPool &);
+
+	void run(){
+		for(int i = m_next++; i < m_end; i = m_next++){ m_task(i); }
+	}
+
+	void work(){
+		ull seen = 0;
+		while(true){
+			{
+				unique_lock<mutex> lock(m_mutex);
+				while(!m_stop && m_generation == seen){ m_start.wait(lock); }
+				if(m_stop){ return; }
+				seen = m_generation;
+			}
+			run();
+			{
+				lock_guard<mutex> lock(m_mutex);
+				if(--m_active == 0){ m_finish.notify_all(); }
+			}
+		}
+	}
+
+public:
+	/**
+	 *  @brief コンストラクタ
+	 *  @param[in] n  並列度 (0の場合はハードウェアのスレッド数)
+	 */
+	explicit ThreadPool(int n = 0) :
+		m_workers(), m_mutex(), m_start(), m_finish(), m_task(),
+		m_next(0), m_end(0), m_active(0), m_generation(0), m_stop(false)
+	{
+		if(n <= 0){ n = max(1u, thread::hardware_concurrency()); }
+		for(int i = 1; i < n; ++i){
+			m_workers.push_back(thread(&ThreadPool::work, this));
+		}
+	}
+
+	/**
+	 *  @brief デストラクタ
+	 *
+	 *  すべてのワーカースレッドを終了させる。
+	 */
+	~ThreadPool(){
+		{
+			lock_guard<mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_start.notify_all();
+		for(size_t i = 0; i < m_workers.size(); ++i){ m_workers[i].join(); }
+	}
+
+	/**
+	 *  @brief 並列度の取得
+	 *  @return 呼び出し元を含めたスレッド数
+	 */
+	int size() const { return static_cast<int>(m_workers.size()) + 1; }
+
+	/**
+	 *  @brief 範囲に対する並列処理
+	 *
+	 *  \f$ i \in [\mathit{begin}, \mathit{end}) \f$ のそれぞれについて
+	 *  f(i) を呼び出し、すべての呼び出しが終わるまで待機する。
+	 *  呼び出し順序は不定。
+	 *
+	 *  @param[in] begin  範囲の始端
+	 *  @param[in] end    範囲の終端
+	 *  @param[in] f      各インデックスに対して呼び出す関数
+	 */
+	template <typename Function>
+	void parallel_for(int begin, int end, Function f){
+		if(m_workers.empty() || end - begin <= 1){
+			for(int i = begin; i < end; ++i){ f(i); }
+			return;
+		}
+		{
+			lock_guard<mutex> lock(m_mutex);
+			m_task = f;
+			m_next = begin;
+			m_end = end;
+			m_active = static_cast<int>(m_workers.size());
+			++m_generation;
+		}
+		m_start.notify_all();
+		run();
+		unique_lock<mutex> lock(m_mutex);
+		while(m_active > 0){ m_finish.wait(lock); }
+		m_task = function<void(int)>();
+	}
+
+};
+
+/**
+ *  @}
+ */
+
+}
+}
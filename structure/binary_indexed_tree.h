@@ -43,7 +43,7 @@ public:
 	 *  @param[in] i  区間の大きさ
 	 *  @return   0番目からi-1番目までの要素の総和
 	 */
-	T sum(int i){
+	T sum(int i) const {
 		T s = T();
 		for(; i > 0; i -= i & -i){ s += data[i]; }
 		return s;
@@ -64,6 +64,29 @@ public:
 		}
 	}
 
+	/**
+	 *  @brief 総和による二分探索
+	 *
+	 *  全要素が非負であるとき、sum(i) <= w を満たす最大の i を求める。
+	 *  計算量は \f$ \mathcal{O}(\log{n}) \f$。
+	 *
+	 *  @param[in] w  総和の上限
+	 *  @return    sum(i) <= w となる最大の i
+	 */
+	int upper_bound(T w) const {
+		const int n = static_cast<int>(data.size()) - 1;
+		int step = 1;
+		while(step * 2 <= n){ step *= 2; }
+		int i = 0;
+		for(; step > 0; step >>= 1){
+			if(i + step <= n && !(w < data[i + step])){
+				i += step;
+				w -= data[i];
+			}
+		}
+		return i;
+	}
+
 };
 
 /**
@@ -0,0 +1,316 @@
+/**
+ *  @file structure/hash_map.h
+ */
+#pragma once
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <iterator>
+#include <chrono>
+#include <type_traits>
+#include "common/header.h"
+
+namespace libcomp {
+namespace structure {
+
+/**
+ *  @defgroup hash_map Hash map
+ *  @ingroup  structure
+ *  @{
+ */
+
+/**
+ *  @brief  splitmix64による整数ハッシュ
+ *
+ *  プロセスごとにランダムなシードを加えてからsplitmix64で撹拌する。
+ *  入力を事前に知っている攻撃者による衝突誘発 (anti-hash) を防ぐ。
+ */
+struct SplitMixHash {
+	/**
+	 *  @brief ハッシュ値の計算
+	 *  @param[in] x  ハッシュ値を求める整数
+	 *  @return    ハッシュ値
+	 */
+	ull operator()(ull x) const {
+		static const ull seed = static_cast<ull>(
+			chrono::steady_clock::now().time_since_epoch().count());
+		x += seed + 0x9e3779b97f4a7c15ull;
+		x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+		x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+		return x ^ (x >> 31);
+	}
+};
+
+/**
+ *  @brief  Robin Hoodハッシュによる開番地法ハッシュマップ
+ *
+ *  整数キーを想定したフラットなハッシュマップ。
+ *  キー・値・探索距離をそれぞれ連続した配列に格納し、
+ *  探索距離の比較による早期打ち切りとbackward shiftによる削除を行う。
+ *  挿入・削除によって既存要素へのポインタは無効になりうる。
+ *
+ *  @tparam K     キーの型 (整数型)
+ *  @tparam V     値の型
+ *  @tparam Hash  ハッシュ関数の型
+ */
+template <typename K, typename V, typename Hash = SplitMixHash>
+class HashMap {
+
+private:
+	static const int MAX_DISTANCE = 255;
+
+	Hash m_hash;
+	vector<unsigned char> m_distances;
+	vector<K> m_keys;
+	vector<V> m_values;
+	size_t m_mask;
+	int m_shift;
+	size_t m_size;
+
+	size_t home(const K &key) const {
+		return static_cast<size_t>(m_hash(static_cast<ull>(key)) >> m_shift);
+	}
+
+	size_t locate(const K &key) const {
+		size_t pos = home(key);
+		for(int d = 1; d <= m_distances[pos]; ++d){
+			if(m_distances[pos] == d && m_keys[pos] == key){ return pos; }
+			pos = (pos + 1) & m_mask;
+		}
+		return m_distances.size();
+	}
+
+	void rehash(size_t capacity){
+		vector<unsigned char> distances(capacity);
+		vector<K> keys(capacity);
+		vector<V> values(capacity);
+		m_distances.swap(distances);
+		m_keys.swap(keys);
+		m_values.swap(values);
+		m_mask = capacity - 1;
+		m_shift = 64;
+		for(size_t c = capacity; c > 1; c >>= 1){ --m_shift; }
+		m_size = 0;
+		for(size_t i = 0; i < distances.size(); ++i){
+			if(distances[i]){ emplace_new(keys[i], values[i]); }
+		}
+	}
+
+	bool needs_grow() const {
+		return (m_size + 1) * 8 > m_distances.size() * 7;
+	}
+
+	V *emplace_new(K key, V value){
+		const K target = key;
+		size_t result = m_distances.size();
+		bool rehashed = false;
+		while(true){
+			size_t pos = home(key);
+			unsigned int d = 1;
+			while(m_distances[pos] && d <= MAX_DISTANCE){
+				if(m_distances[pos] < d){
+					if(result == m_distances.size()){ result = pos; }
+					swap(m_keys[pos], key);
+					swap(m_values[pos], value);
+					const unsigned int t = m_distances[pos];
+					m_distances[pos] = static_cast<unsigned char>(d);
+					d = t;
+				}
+				pos = (pos + 1) & m_mask;
+				++d;
+			}
+			if(d <= MAX_DISTANCE){
+				if(result == m_distances.size()){ result = pos; }
+				m_distances[pos] = static_cast<unsigned char>(d);
+				m_keys[pos] = key;
+				m_values[pos] = value;
+				++m_size;
+				break;
+			}
+			// 探索距離が上限を超えた場合は拡張して残りの要素を挿入し直す
+			rehash(m_distances.size() * 2);
+			result = m_distances.size();
+			rehashed = true;
+		}
+		return rehashed ? &m_values[locate(target)] : &m_values[result];
+	}
+
+public:
+	/**
+	 *  @brief コンストラクタ
+	 *
+	 *  要素を含まない状態でハッシュマップを初期化する。
+	 *
+	 *  @param[in] n     あらかじめ確保する要素数
+	 *  @param[in] hash  ハッシュ関数
+	 */
+	explicit HashMap(size_t n = 0, const Hash &hash = Hash()) :
+		m_hash(hash), m_distances(), m_keys(), m_values(),
+		m_mask(0), m_shift(64), m_size(0)
+	{
+		rehash(16);
+		reserve(n);
+	}
+
+	/**
+	 *  @brief 要素数の取得
+	 *  @return 格納されている要素数
+	 */
+	size_t size() const { return m_size; }
+
+	/**
+	 *  @brief ハッシュマップが空であるかの判定
+	 *  @retval true   要素が含まれていない
+	 *  @retval false  要素が含まれている
+	 */
+	bool empty() const { return m_size == 0; }
+
+	/**
+	 *  @brief 容量の予約
+	 *
+	 *  n要素を再構築なしで格納できるように容量を拡張する。
+	 *
+	 *  @param[in] n  格納する予定の要素数
+	 */
+	void reserve(size_t n){
+		size_t capacity = m_distances.size();
+		while(n * 8 > capacity * 7){ capacity *= 2; }
+		if(capacity != m_distances.size()){ rehash(capacity); }
+	}
+
+	/**
+	 *  @brief 全要素の削除
+	 */
+	void clear(){
+		fill(m_distances.begin(), m_distances.end(), 0);
+		m_size = 0;
+	}
+
+	/**
+	 *  @brief 要素の検索
+	 *  @param[in] key  検索するキー
+	 *  @return    キーに対応する値へのポインタ。存在しない場合はNULL。
+	 */
+	V *find(const K &key){
+		const size_t pos = locate(key);
+		return pos == m_distances.size() ? NULL : &m_values[pos];
+	}
+
+	/**
+	 *  @brief 要素の検索
+	 *  @param[in] key  検索するキー
+	 *  @return    キーに対応する値へのポインタ。存在しない場合はNULL。
+	 */
+	const V *find(const K &key) const {
+		const size_t pos = locate(key);
+		return pos == m_distances.size() ? NULL : &m_values[pos];
+	}
+
+	/**
+	 *  @brief 要素数の計数
+	 *  @param[in] key  検索するキー
+	 *  @return    キーが含まれていれば1、そうでなければ0
+	 */
+	size_t count(const K &key) const {
+		return locate(key) == m_distances.size() ? 0 : 1;
+	}
+
+	/**
+	 *  @brief 要素の挿入
+	 *
+	 *  キーが含まれていない場合のみ (key, value) を挿入する。
+	 *  計算量は \f$ \mathcal{O}(1) \f$ (expected, amortized)。
+	 *
+	 *  @param[in] key    挿入するキー
+	 *  @param[in] value  挿入する値
+	 *  @retval    true   挿入が行われた
+	 *  @retval    false  キーがすでに含まれていた
+	 */
+	bool insert(const K &key, const V &value){
+		if(locate(key) != m_distances.size()){ return false; }
+		if(needs_grow()){ rehash(m_distances.size() * 2); }
+		emplace_new(key, value);
+		return true;
+	}
+
+	/**
+	 *  @brief 要素の一括挿入
+	 *
+	 *  (キー, 値) の組の列 [first, last) を挿入する。
+	 *  要素数が既知の場合は最初に一度だけ容量を確保する。
+	 *
+	 *  @param[in] first  組の列の先頭を指すイテレータ
+	 *  @param[in] last   組の列の終端を指すイテレータ
+	 */
+	template <typename Iterator>
+	void insert(Iterator first, Iterator last){
+		typedef typename iterator_traits<Iterator>::iterator_category category;
+		if(is_base_of<forward_iterator_tag, category>::value){
+			reserve(m_size + distance(first, last));
+		}
+		for(; first != last; ++first){ insert(first->first, first->second); }
+	}
+
+	/**
+	 *  @brief 要素へのアクセス
+	 *
+	 *  キーに対応する値への参照を返す。
+	 *  キーが含まれていない場合は値を V() として挿入する。
+	 *
+	 *  @param[in] key  キー
+	 *  @return    キーに対応する値への参照
+	 */
+	V &operator[](const K &key){
+		const size_t pos = locate(key);
+		if(pos != m_distances.size()){ return m_values[pos]; }
+		if(needs_grow()){ rehash(m_distances.size() * 2); }
+		return *emplace_new(key, V());
+	}
+
+	/**
+	 *  @brief 要素の削除
+	 *
+	 *  キーに対応する要素を削除し、後続の要素を前に詰める。
+	 *
+	 *  @param[in] key  削除するキー
+	 *  @return    削除された要素数
+	 */
+	size_t erase(const K &key){
+		size_t pos = locate(key);
+		if(pos == m_distances.size()){ return 0; }
+		size_t next = (pos + 1) & m_mask;
+		while(m_distances[next] > 1){
+			m_distances[pos] = m_distances[next] - 1;
+			m_keys[pos] = m_keys[next];
+			m_values[pos] = m_values[next];
+			pos = next;
+			next = (next + 1) & m_mask;
+		}
+		m_distances[pos] = 0;
+		--m_size;
+		return 1;
+	}
+
+	/**
+	 *  @brief 全要素の走査
+	 *
+	 *  格納されているすべての (キー, 値) について f(key, value) を呼び出す。
+	 *  順序は不定。
+	 *
+	 *  @param[in] f  呼び出す関数
+	 */
+	template <typename Function>
+	void for_each(Function f) const {
+		for(size_t i = 0; i < m_distances.size(); ++i){
+			if(m_distances[i]){ f(m_keys[i], m_values[i]); }
+		}
+	}
+
+};
+
+/**
+ *  @}
+ */
+
+}
+}
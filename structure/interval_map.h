@@ -0,0 +1,179 @@
+/**
+ *  @file structure/interval_map.h
+ */
+#pragma once
+#include <map>
+#include <utility>
+#include <functional>
+#include <cassert>
+#include "common/header.h"
+#include "structure/pool_allocator.h"
+
+namespace libcomp {
+namespace structure {
+
+/**
+ *  @defgroup interval_map Interval map
+ *  @ingroup  structure
+ *  @{
+ */
+
+/**
+ *  @brief  区間代入を扱う区間マップ (ODT)
+ *
+ *  定義域 [left, right) を値が一定である極大な区間 (ラン) の列として保持する。
+ *  各ランは開始位置をキーとした平衡二分木のノードとして表現され、
+ *  ノードは PoolAllocator から確保される。
+ *  メモリ使用量はランの数に比例する。
+ *
+ *  @tparam K  位置の型 (整数型)
+ *  @tparam V  値の型 (等値比較可能であること)
+ */
+template <typename K, typename V>
+class IntervalMap {
+
+public:
+	/// ランを保持するコンテナの型
+	typedef map< K, V, less<K>, PoolAllocator< pair<const K, V> > > container_type;
+	/// ランを指すイテレータ
+	typedef typename container_type::iterator iterator;
+	/// ランを指すイテレータ
+	typedef typename container_type::const_iterator const_iterator;
+
+private:
+	container_type m_runs;
+	K m_left;
+	K m_right;
+
+	void merge_at(iterator it){
+		if(it == m_runs.end() || it == m_runs.begin()){ return; }
+		iterator prev = it;
+		--prev;
+		if(prev->second == it->second){ m_runs.erase(it); }
+	}
+
+public:
+	/**
+	 *  @brief コンストラクタ
+	 *
+	 *  定義域 [left, right) 全体が値 value である状態に初期化する。
+	 *
+	 *  @param[in] left   定義域の下限
+	 *  @param[in] right  定義域の上限
+	 *  @param[in] value  初期値
+	 */
+	IntervalMap(const K &left, const K &right, const V &value = V()) :
+		m_runs(), m_left(left), m_right(right)
+	{
+		assert(left < right);
+		m_runs.insert(make_pair(left, value));
+	}
+
+	/**
+	 *  @brief ランの数の取得
+	 *  @return 保持しているランの数
+	 */
+	size_t size() const { return m_runs.size(); }
+
+	/**
+	 *  @brief 位置xでの分割
+	 *
+	 *  位置xがランの境界となるように、xを含むランを2つに分割する。
+	 *  分割の結果として隣接するランが同じ値を持つことがある。
+	 *  計算量は \f$ \mathcal{O}(\log{n}) \f$ (nはランの数)。
+	 *
+	 *  @param[in] x  分割する位置
+	 *  @return    xから始まるランを指すイテレータ (x == right の場合はend())
+	 */
+	iterator split(const K &x){
+		assert(m_left <= x && x <= m_right);
+		if(x == m_right){ return m_runs.end(); }
+		iterator it = m_runs.upper_bound(x);
+		--it;
+		if(it->first == x){ return it; }
+		return m_runs.insert(it, make_pair(x, it->second));
+	}
+
+	/**
+	 *  @brief 区間代入
+	 *
+	 *  [l, r) の値をすべてvに置き換え、隣接するランと値が等しければ併合する。
+	 *  計算量は \f$ \mathcal{O}(\log{n} + k) \f$ (kは取り除かれるランの数)。
+	 *
+	 *  @param[in] l  区間の始端
+	 *  @param[in] r  区間の終端
+	 *  @param[in] v  代入する値
+	 */
+	void assign(const K &l, const K &r, const V &v){
+		assert(m_left <= l && r <= m_right);
+		if(!(l < r)){ return; }
+		iterator last = split(r);
+		iterator first = split(l);
+		m_runs.erase(first, last);
+		iterator it = m_runs.insert(last, make_pair(l, v));
+		merge_at(last);
+		merge_at(it);
+	}
+
+	/**
+	 *  @brief 位置xの値の取得
+	 *
+	 *  計算量は \f$ \mathcal{O}(\log{n}) \f$。
+	 *
+	 *  @param[in] x  値を取得する位置
+	 *  @return    位置xの値
+	 */
+	const V &get(const K &x) const {
+		assert(m_left <= x && x < m_right);
+		const_iterator it = m_runs.upper_bound(x);
+		--it;
+		return it->second;
+	}
+
+	/**
+	 *  @brief 区間内のランの走査
+	 *
+	 *  [l, r) と重なるすべてのランについて、
+	 *  [l, r) との共通部分 [a, b) とその値vを用いて f(a, b, v) を呼び出す。
+	 *  ランの分割は行わない。
+	 *  計算量は \f$ \mathcal{O}(\log{n} + k) \f$ (kは走査したランの数)。
+	 *
+	 *  @param[in] l  区間の始端
+	 *  @param[in] r  区間の終端
+	 *  @param[in] f  呼び出す関数
+	 */
+	template <typename Function>
+	void for_each(const K &l, const K &r, Function f) const {
+		assert(m_left <= l && r <= m_right);
+		if(!(l < r)){ return; }
+		const_iterator it = m_runs.upper_bound(l);
+		--it;
+		while(it != m_runs.end() && it->first < r){
+			const_iterator next = it;
+			++next;
+			const K a = it->first < l ? l : it->first;
+			const K b = (next == m_runs.end() || r < next->first) ? r : next->first;
+			f(a, b, it->second);
+			it = next;
+		}
+	}
+
+	/**
+	 *  @brief 先頭のランを指すイテレータの取得
+	 *  @return 先頭のランを指すイテレータ
+	 */
+	const_iterator begin() const { return m_runs.begin(); }
+	/**
+	 *  @brief 終端を指すイテレータの取得
+	 *  @return 終端を指すイテレータ
+	 */
+	const_iterator end() const { return m_runs.end(); }
+
+};
+
+/**
+ *  @}
+ */
+
+}
+}
@@ -0,0 +1,180 @@
+/**
+ *  @file structure/leftist_heap.h
+ */
+#pragma once
+#include <vector>
+#include <functional>
+#include <algorithm>
+#include <cassert>
+#include "common/header.h"
+
+namespace libcomp {
+namespace structure {
+
+/**
+ *  @defgroup leftist_heap Leftist heap
+ *  @ingroup  structure
+ *  @{
+ */
+
+/**
+ *  @brief  併合可能な左傾ヒープの集合
+ *
+ *  複数のヒープのノードを1つの連続した領域 (アリーナ) で管理する。
+ *  各ヒープは根のノード番号で表し、空のヒープは -1 で表す。
+ *  ヒープ全体への定数加算を遅延評価で扱う。
+ *  比較関数 F について最小の要素が根となる。
+ *
+ *  @tparam T  値の型 (加算と T() による零元を持つこと)
+ *  @tparam F  比較関数の型
+ */
+template < typename T, typename F = std::less<T> >
+class LeftistHeap {
+
+private:
+	struct Node {
+		T value;
+		T lazy;
+		int left;
+		int right;
+		int rank;
+	};
+
+	vector<Node> m_nodes;
+	vector<int> m_free;
+	F m_comparator;
+
+	void apply(int k, const T &d){
+		if(k < 0){ return; }
+		m_nodes[k].value = m_nodes[k].value + d;
+		m_nodes[k].lazy = m_nodes[k].lazy + d;
+	}
+
+	void push_down(int k){
+		Node &node = m_nodes[k];
+		if(node.lazy == T()){ return; }
+		apply(node.left, node.lazy);
+		apply(node.right, node.lazy);
+		node.lazy = T();
+	}
+
+	int rank(int k) const { return k < 0 ? 0 : m_nodes[k].rank; }
+
+public:
+	/**
+	 *  @brief コンストラクタ
+	 *
+	 *  ノードを持たない状態で初期化する。
+	 *
+	 *  @param[in] capacity    あらかじめ確保するノード数
+	 *  @param[in] comparator  比較関数
+	 */
+	explicit LeftistHeap(size_t capacity = 0, const F &comparator = F()) :
+		m_nodes(), m_free(), m_comparator(comparator)
+	{
+		m_nodes.reserve(capacity);
+	}
+
+	/**
+	 *  @brief 1要素からなるヒープの生成
+	 *  @param[in] x  要素の値
+	 *  @return    生成されたヒープ
+	 */
+	int make(const T &x){
+		Node node;
+		node.value = x;
+		node.lazy = T();
+		node.left = node.right = -1;
+		node.rank = 1;
+		if(!m_free.empty()){
+			const int k = m_free.back();
+			m_free.pop_back();
+			m_nodes[k] = node;
+			return k;
+		}
+		m_nodes.push_back(node);
+		return static_cast<int>(m_nodes.size()) - 1;
+	}
+
+	/**
+	 *  @brief ヒープの併合
+	 *
+	 *  ヒープaとヒープbを併合する。a, b はこれ以降使用できない。
+	 *  計算量は \f$ \mathcal{O}(\log{n}) \f$。
+	 *
+	 *  @param[in] a  併合するヒープ
+	 *  @param[in] b  併合するヒープ
+	 *  @return    併合されたヒープ
+	 */
+	int meld(int a, int b){
+		if(a < 0){ return b; }
+		if(b < 0){ return a; }
+		if(m_comparator(m_nodes[b].value, m_nodes[a].value)){ swap(a, b); }
+		push_down(a);
+		const int r = meld(m_nodes[a].right, b);
+		Node &node = m_nodes[a];
+		node.right = r;
+		if(rank(node.left) < rank(node.right)){ swap(node.left, node.right); }
+		node.rank = rank(node.right) + 1;
+		return a;
+	}
+
+	/**
+	 *  @brief 要素の追加
+	 *
+	 *  計算量は \f$ \mathcal{O}(\log{n}) \f$。
+	 *
+	 *  @param[in] h  追加先のヒープ
+	 *  @param[in] x  追加する値
+	 *  @return    追加後のヒープ
+	 */
+	int push(int h, const T &x){
+		return meld(h, make(x));
+	}
+
+	/**
+	 *  @brief 最小要素の取得
+	 *  @param[in] h  対象のヒープ (空でないこと)
+	 *  @return    ヒープに含まれる最小の値
+	 */
+	const T &top(int h) const {
+		assert(h >= 0);
+		return m_nodes[h].value;
+	}
+
+	/**
+	 *  @brief 最小要素の削除
+	 *
+	 *  計算量は \f$ \mathcal{O}(\log{n}) \f$。
+	 *
+	 *  @param[in] h  対象のヒープ (空でないこと)
+	 *  @return    削除後のヒープ
+	 */
+	int pop(int h){
+		assert(h >= 0);
+		push_down(h);
+		m_free.push_back(h);
+		return meld(m_nodes[h].left, m_nodes[h].right);
+	}
+
+	/**
+	 *  @brief ヒープ全体への加算
+	 *
+	 *  ヒープに含まれる全要素にdを加算する。
+	 *  計算量は \f$ \mathcal{O}(1) \f$。
+	 *
+	 *  @param[in] h  対象のヒープ
+	 *  @param[in] d  加算する値
+	 */
+	void add(int h, const T &d){
+		apply(h, d);
+	}
+
+};
+
+/**
+ *  @}
+ */
+
+}
+}
@@ -0,0 +1,178 @@
+/**
+ *  @file structure/mapped_segment_tree.h
+ */
+#pragma once
+#include <type_traits>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "common/header.h"
+#include "structure/segment_tree.h"
+
+namespace libcomp {
+namespace structure {
+
+/**
+ *  @addtogroup segment_tree
+ *  @{
+ */
+
+/**
+ *  @brief  メモリマップされた読み取り専用のセグメント木
+ *
+ *  SegmentTree::save で書き出されたスナップショットを mmap し、
+ *  節点の配列をコピーせずにそのまま問い合わせに用いる。
+ *  POSIX環境でのみ利用可能。
+ *
+ *  @sa SegmentTree::map
+ *  @tparam Traits  セグメント木の動作を示す型
+ */
+template <typename Traits>
+class MappedSegmentTree {
+
+public:
+	/// 値型
+	typedef typename Traits::value_type value_type;
+
+private:
+	Traits m_traits;
+	void *m_image;
+	size_t m_image_size;
+	const value_type *m_data;
+	size_t m_size;
+
+	MappedSegmentTree(const MappedSegmentTree &);
+	MappedSegmentTree &operator=(const MappedSegmentTree &);
+
+	void open(const char *path){
+		const int fd = ::open(path, O_RDONLY);
+		if(fd < 0){ return; }
+		struct stat st;
+		if(fstat(fd, &st) != 0 ||
+		   static_cast<size_t>(st.st_size) < sizeof(SegmentTreeImageHeader))
+		{
+			::close(fd);
+			return;
+		}
+		void *image = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+		::close(fd);
+		if(image == MAP_FAILED){ return; }
+		const SegmentTreeImageHeader *header =
+			static_cast<const SegmentTreeImageHeader *>(image);
+		// leaves はファイル由来の値なので、乗算の前に範囲を確認する
+		const size_t capacity =
+			(static_cast<size_t>(st.st_size) - sizeof(SegmentTreeImageHeader)) / sizeof(value_type);
+		if(!header->template validate<Traits>() ||
+		   header->leaves == 0 || header->leaves > capacity ||
+		   static_cast<size_t>(st.st_size) != sizeof(SegmentTreeImageHeader) +
+		   sizeof(value_type) * (header->leaves * 2 - 1))
+		{
+			munmap(image, st.st_size);
+			return;
+		}
+		m_image = image;
+		m_image_size = st.st_size;
+		m_data = reinterpret_cast<const value_type *>(header + 1);
+		m_size = header->leaves;
+	}
+
+	void close(){
+		if(m_image){ munmap(m_image, m_image_size); }
+		m_image = NULL;
+		m_image_size = 0;
+		m_data = NULL;
+		m_size = 0;
+	}
+
+	value_type query(int a, int b, int k, int l, int r) const {
+		if(r <= a || b <= l){ return m_traits.default_value(); }
+		if(a <= l && r <= b){ return m_data[k]; }
+		const value_type vl = query(a, b, k * 2 + 1, l, (l + r) / 2);
+		const value_type vr = query(a, b, k * 2 + 2, (l + r) / 2, r);
+		return m_traits(vl, vr);
+	}
+
+public:
+	/**
+	 *  @brief コンストラクタ
+	 *
+	 *  スナップショットを読み取り専用でマップする。
+	 *  ファイルが存在しない場合やヘッダ・Traitsが一致しない場合は
+	 *  is_open() が false となる。
+	 *
+	 *  @param[in] path    マップするファイル名
+	 *  @param[in] traits  処理内容を示す関数オブジェクト
+	 */
+	explicit MappedSegmentTree(
+		const char *path, const Traits &traits = Traits()) :
+		m_traits(traits), m_image(NULL), m_image_size(0),
+		m_data(NULL), m_size(0)
+	{
+		static_assert(
+			is_trivially_copyable<value_type>::value,
+			"value_type must be trivially copyable");
+		open(path);
+	}
+
+	/**
+	 *  @brief ムーブコンストラクタ
+	 *  @param[in,out] t  ムーブ元のセグメント木
+	 */
+	MappedSegmentTree(MappedSegmentTree &&t) :
+		m_traits(t.m_traits), m_image(t.m_image),
+		m_image_size(t.m_image_size), m_data(t.m_data), m_size(t.m_size)
+	{
+		t.m_image = NULL;
+		t.close();
+	}
+
+	/**
+	 *  @brief デストラクタ
+	 *
+	 *  マップしたスナップショットを解放する。
+	 */
+	~MappedSegmentTree(){ close(); }
+
+	/**
+	 *  @brief マップに成功したかの判定
+	 *  @retval true   スナップショットがマップされている
+	 *  @retval false  マップに失敗した
+	 */
+	bool is_open() const { return m_data != NULL; }
+
+	/**
+	 *  @brief 区間についての問い合わせ
+	 *
+	 *  インデックスが区間 [a, b) に含まれる要素すべてを結合した結果を求める。
+	 *  計算量は \f$ \mathcal{O}(\log{n}) \f$。
+	 *
+	 *  @param[in] a  区間の始端
+	 *  @param[in] b  区間の終端
+	 *  @return    計算された結果
+	 */
+	value_type query(size_t a, size_t b) const {
+		return query(a, b, 0, 0, m_size);
+	}
+
+	/**
+	 *  @brief 葉の取得
+	 *
+	 *  i番目の葉の値を取得する。
+	 *  計算量は \f$ \mathcal{O}(1) \f$。
+	 *
+	 *  @param[in] i  取得する葉のインデックス
+	 *  @return    取得された値
+	 */
+	value_type operator[](size_t i) const {
+		return m_data[m_size - 1 + i];
+	}
+
+};
+
+/**
+ *  @}
+ */
+
+}
+}
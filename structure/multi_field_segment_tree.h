@@ -0,0 +1,208 @@
+/**
+ *  @file structure/multi_field_segment_tree.h
+ */
+#pragma once
+#include <vector>
+#include <tuple>
+#include <utility>
+#include <iterator>
+#include "common/header.h"
+
+namespace libcomp {
+namespace structure {
+
+/**
+ *  @addtogroup segment_tree
+ *  @{
+ */
+
+/**
+ *  @brief  フィールドごとに配列を分割したセグメント木
+ *
+ *  SegmentTree と同じTraitsを受け取るが、value_type は std::tuple であり、
+ *  各フィールドをそれぞれ独立した配列 (structure of arrays) に格納する。
+ *  query_fields で一部のフィールドのみを問い合わせた場合、
+ *  それ以外のフィールドの配列には一切アクセスしない。
+ *
+ *  @sa SegmentTree
+ *  @tparam Traits  セグメント木の動作を示す型 (value_type は std::tuple)
+ */
+template <typename Traits>
+class MultiFieldSegmentTree {
+
+public:
+	/// 値型
+	typedef typename Traits::value_type value_type;
+
+private:
+	template <typename T> struct Storage;
+	template <typename... Ts>
+	struct Storage< tuple<Ts...> > {
+		typedef tuple< vector<Ts>... > type;
+		static const size_t size = sizeof...(Ts);
+	};
+
+	typedef make_index_sequence<Storage<value_type>::size> all_fields;
+
+	Traits m_traits;
+	typename Storage<value_type>::type m_fields;
+	value_type m_default;
+	size_t m_size;
+
+	template <size_t... I>
+	void resize(size_t n, index_sequence<I...>){
+		int expand[] = { 0, (get<I>(m_fields).assign(n, get<I>(m_default)), 0)... };
+		(void)expand;
+	}
+
+	template <size_t... I>
+	value_type load(size_t k, index_sequence<I...>) const {
+		value_type v = m_default;
+		int expand[] = { 0, (get<I>(v) = get<I>(m_fields)[k], 0)... };
+		(void)expand;
+		return v;
+	}
+
+	template <size_t... I>
+	void store(size_t k, const value_type &v, index_sequence<I...>){
+		int expand[] = { 0, (get<I>(m_fields)[k] = get<I>(v), 0)... };
+		(void)expand;
+	}
+
+	void initialize(){
+		for(int i = static_cast<int>(m_size) - 2; i >= 0; --i){
+			store(i, m_traits(
+				load(i * 2 + 1, all_fields()),
+				load(i * 2 + 2, all_fields())), all_fields());
+		}
+	}
+
+	template <typename Fields>
+	value_type query(int a, int b, int k, int l, int r, Fields f) const {
+		if(r <= a || b <= l){ return m_default; }
+		if(a <= l && r <= b){ return load(k, f); }
+		const value_type vl = query(a, b, k * 2 + 1, l, (l + r) / 2, f);
+		const value_type vr = query(a, b, k * 2 + 2, (l + r) / 2, r, f);
+		return m_traits(vl, vr);
+	}
+
+public:
+	/**
+	 *  @brief コンストラクタ (既定値で初期化)
+	 *
+	 *  葉をすべて既定値で初期化した状態のセグメント木を構築する。
+	 *  計算量は \f$ \mathcal{O}(n) \f$。
+	 *
+	 *  @param[in] size    最低限必要な葉の数
+	 *  @param[in] traits  処理内容を示す関数オブジェクト
+	 */
+	explicit MultiFieldSegmentTree(
+		size_t size = 0, const Traits &traits = Traits()) :
+		m_traits(traits), m_fields(), m_default(m_traits.default_value()),
+		m_size(1)
+	{
+		while(m_size < size){ m_size *= 2; }
+		resize(m_size * 2 - 1, all_fields());
+		initialize();
+	}
+
+	/**
+	 *  @brief コンストラクタ (要素列による初期化)
+	 *
+	 *  葉をすべて [first, last) で初期化した状態のセグメント木を構築する。
+	 *  計算量は \f$ \mathcal{O}(n) (n = distance(first, last)) \f$。
+	 *
+	 *  @param[in] first   要素列の先頭を指すイテレータ
+	 *  @param[in] last    要素列の終端を指すイテレータ
+	 *  @param[in] traits  処理内容を示す関数オブジェクト
+	 */
+	template <typename Iterator>
+	MultiFieldSegmentTree(
+		Iterator first, Iterator last, const Traits &traits = Traits()) :
+		m_traits(traits), m_fields(), m_default(m_traits.default_value()),
+		m_size(1)
+	{
+		const size_t n = distance(first, last);
+		while(m_size < n){ m_size *= 2; }
+		resize(m_size * 2 - 1, all_fields());
+		for(size_t i = m_size - 1; first != last; ++first, ++i){
+			store(i, *first, all_fields());
+		}
+		initialize();
+	}
+
+	/**
+	 *  @brief 葉の更新
+	 *
+	 *  i番目の葉の値をvalで更新する。また、必要に応じて節点の値も更新する。
+	 *  計算量は \f$ \mathcal{O}(\log{n}) \f$。
+	 *
+	 *  @param[in] i    更新したい葉のインデックス
+	 *  @param[in] val  更新後の値
+	 */
+	void update(size_t i, const value_type &val){
+		i += m_size - 1;
+		store(i, val, all_fields());
+		while(i > 0){
+			i = (i - 1) / 2;
+			store(i, m_traits(
+				load(i * 2 + 1, all_fields()),
+				load(i * 2 + 2, all_fields())), all_fields());
+		}
+	}
+
+	/**
+	 *  @brief 区間についての問い合わせ
+	 *
+	 *  インデックスが区間 [a, b) に含まれる要素すべてを結合した結果を求める。
+	 *  計算量は \f$ \mathcal{O}(\log{n}) \f$。
+	 *
+	 *  @param[in] a  区間の始端
+	 *  @param[in] b  区間の終端
+	 *  @return    計算された結果
+	 */
+	value_type query(size_t a, size_t b) const {
+		return query(a, b, 0, 0, m_size, all_fields());
+	}
+
+	/**
+	 *  @brief 一部のフィールドについての区間問い合わせ
+	 *
+	 *  フィールド I... の配列のみを読み出して区間 [a, b) を結合する。
+	 *  それ以外のフィールドは既定値として扱われるため、
+	 *  戻り値のうち意味を持つのは I... のフィールドのみである。
+	 *  I... は結合演算について閉じている (I... の結果が
+	 *  I... 以外のフィールドに依存しない) 必要がある。
+	 *  計算量は \f$ \mathcal{O}(\log{n}) \f$。
+	 *
+	 *  @tparam    I  問い合わせるフィールドのインデックス
+	 *  @param[in] a  区間の始端
+	 *  @param[in] b  区間の終端
+	 *  @return    計算された結果
+	 */
+	template <size_t... I>
+	value_type query_fields(size_t a, size_t b) const {
+		return query(a, b, 0, 0, m_size, index_sequence<I...>());
+	}
+
+	/**
+	 *  @brief 葉の取得
+	 *
+	 *  i番目の葉の値を取得する。
+	 *  計算量は \f$ \mathcal{O}(1) \f$。
+	 *
+	 *  @param[in] i  取得する葉のインデックス
+	 *  @return    取得された値
+	 */
+	value_type operator[](size_t i) const {
+		return load(m_size - 1 + i, all_fields());
+	}
+
+};
+
+/**
+ *  @}
+ */
+
+}
+}
@@ -0,0 +1,407 @@
+/**
+ *  @file structure/order_statistics_multiset.h
+ */
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include "common/header.h"
+#include "structure/binary_indexed_tree.h"
+
+namespace libcomp {
+namespace structure {
+
+/**
+ *  @defgroup order_statistics_multiset Order statistics multiset
+ *  @ingroup  structure
+ *  @{
+ */
+
+/**
+ *  @brief  BITと動的な座標圧縮による順序統計多重集合
+ *
+ *  既知のキー集合 (圧縮済みの座標) 上のBITで各キーの個数を管理する。
+ *  未知のキーは部分木の大きさを持つ treap (保留領域) に置き、
+ *  保留領域の大きさが圧縮済みの座標の数を超えたときに、
+ *  個数0になったキーを捨てつつ座標を圧縮し直してBITを再構築する。
+ *  再構築の費用は直前の再構築以降に挿入された未知のキーに按分できるため、
+ *  insert / erase / rank / count は償却 \f$ \mathcal{O}(\log{n}) \f$、
+ *  kth は \f$ \mathcal{O}(\log^2{n}) \f$。
+ */
+class OrderStatisticsMultiset {
+
+private:
+	struct Node {
+		ll key;
+		unsigned int priority;
+		int size;
+		int left;
+		int right;
+	};
+
+	vector<ll> m_keys;
+	vector<int> m_counts;
+	BinaryIndexedTree<int> m_bit;
+	vector<Node> m_nodes;
+	vector<int> m_free;
+	int m_root;
+	unsigned int m_seed;
+	size_t m_size;
+
+	int index_of(ll x) const {
+		const int i = lower_bound(m_keys.begin(), m_keys.end(), x) - m_keys.begin();
+		if(i < static_cast<int>(m_keys.size()) && m_keys[i] == x){ return i; }
+		return -1;
+	}
+
+	ll main_kth(int k) const {
+		return m_keys[m_bit.upper_bound(k)];
+	}
+
+	int node_size(int t) const { return t < 0 ? 0 : m_nodes[t].size; }
+
+	void update(int t){
+		m_nodes[t].size = 1 + node_size(m_nodes[t].left) + node_size(m_nodes[t].right);
+	}
+
+	int merge(int a, int b){
+		if(a < 0){ return b; }
+		if(b < 0){ return a; }
+		if(m_nodes[a].priority > m_nodes[b].priority){
+			m_nodes[a].right = merge(m_nodes[a].right, b);
+			update(a);
+			return a;
+		}
+		m_nodes[b].left = merge(a, m_nodes[b].left);
+		update(b);
+		return b;
+	}
+
+	// t を x 未満のキーからなる a と x 以上のキーからなる b に分ける
+	void split(int t, ll x, int &a, int &b){
+		if(t < 0){
+			a = b = -1;
+			return;
+		}
+		if(m_nodes[t].key < x){
+			int r;
+			split(m_nodes[t].right, x, r, b);
+			m_nodes[t].right = r;
+			a = t;
+		}else{
+			int l;
+			split(m_nodes[t].left, x, a, l);
+			m_nodes[t].left = l;
+			b = t;
+		}
+		update(t);
+	}
+
+	int remove_min(int t){
+		if(m_nodes[t].left < 0){
+			m_free.push_back(t);
+			return m_nodes[t].right;
+		}
+		m_nodes[t].left = remove_min(m_nodes[t].left);
+		update(t);
+		return t;
+	}
+
+	// 保留領域のうち x 未満 (inclusive なら x 以下) のキーの個数
+	int pending_rank(ll x, bool inclusive) const {
+		int r = 0;
+		for(int t = m_root; t >= 0; ){
+			const Node &node = m_nodes[t];
+			if(node.key < x || (inclusive && node.key == x)){
+				r += node_size(node.left) + 1;
+				t = node.right;
+			}else{
+				t = node.left;
+			}
+		}
+		return r;
+	}
+
+	ll pending_kth(int k) const {
+		int t = m_root;
+		while(true){
+			const int l = node_size(m_nodes[t].left);
+			if(k < l){
+				t = m_nodes[t].left;
+			}else if(k == l){
+				return m_nodes[t].key;
+			}else{
+				k -= l + 1;
+				t = m_nodes[t].right;
+			}
+		}
+	}
+
+	void collect(int t, vector<ll> &out) const {
+		if(t < 0){ return; }
+		collect(m_nodes[t].left, out);
+		out.push_back(m_nodes[t].key);
+		collect(m_nodes[t].right, out);
+	}
+
+public:
+	/**
+	 *  @brief コンストラクタ
+	 *
+	 *  空の多重集合を構築する。
+	 */
+	OrderStatisticsMultiset() :
+		m_keys(), m_counts(), m_bit(0), m_nodes(), m_free(),
+		m_root(-1), m_seed(2463534242u), m_size(0)
+	{ }
+
+	/**
+	 *  @brief 要素数の取得
+	 *  @return 含まれている要素数 (重複を含む)
+	 */
+	size_t size() const { return m_size; }
+
+	/**
+	 *  @brief 多重集合が空であるかの判定
+	 *  @retval true   要素が含まれていない
+	 *  @retval false  要素が含まれている
+	 */
+	bool empty() const { return m_size == 0; }
+
+	/**
+	 *  @brief 座標の再構築
+	 *
+	 *  保留領域のキーを座標に取り込み、個数が0になったキーを取り除いて
+	 *  BITを構築し直す。計算量は \f$ \mathcal{O}(n \log{n}) \f$。
+	 */
+	void rebuild(){
+		vector<ll> pending;
+		pending.reserve(node_size(m_root));
+		collect(m_root, pending);
+		vector<ll> keys;
+		vector<int> counts;
+		size_t i = 0, j = 0;
+		while(i < m_keys.size() || j < pending.size()){
+			ll x;
+			int c;
+			if(j == pending.size() ||
+			   (i < m_keys.size() && m_keys[i] <= pending[j]))
+			{
+				x = m_keys[i];
+				c = m_counts[i++];
+			}else{
+				x = pending[j++];
+				c = 1;
+			}
+			if(c == 0){ continue; }
+			if(!keys.empty() && keys.back() == x){
+				counts.back() += c;
+			}else{
+				keys.push_back(x);
+				counts.push_back(c);
+			}
+		}
+		m_keys.swap(keys);
+		m_counts.swap(counts);
+		m_nodes.clear();
+		m_free.clear();
+		m_root = -1;
+		m_bit = BinaryIndexedTree<int>(m_keys.size());
+		for(size_t i = 0; i < m_keys.size(); ++i){ m_bit.add(i, m_counts[i]); }
+	}
+
+	/**
+	 *  @brief 要素の挿入
+	 *  @param[in] x  挿入する値
+	 */
+	void insert(ll x){
+		++m_size;
+		const int i = index_of(x);
+		if(i >= 0){
+			++m_counts[i];
+			m_bit.add(i, 1);
+			return;
+		}
+		int t;
+		if(m_free.empty()){
+			t = m_nodes.size();
+			m_nodes.push_back(Node());
+		}else{
+			t = m_free.back();
+			m_free.pop_back();
+		}
+		m_seed ^= m_seed << 13;
+		m_seed ^= m_seed >> 17;
+		m_seed ^= m_seed << 5;
+		Node &node = m_nodes[t];
+		node.key = x;
+		node.priority = m_seed;
+		node.size = 1;
+		node.left = node.right = -1;
+		int a, b;
+		split(m_root, x, a, b);
+		m_root = merge(merge(a, t), b);
+		if(static_cast<size_t>(node_size(m_root)) > m_keys.size() + 64){ rebuild(); }
+	}
+
+	/**
+	 *  @brief 要素の削除
+	 *
+	 *  xが含まれていればそのうち1つを取り除く。
+	 *
+	 *  @param[in] x      削除する値
+	 *  @retval    true   要素が削除された
+	 *  @retval    false  xが含まれていなかった
+	 */
+	bool erase(ll x){
+		const int i = index_of(x);
+		if(i >= 0 && m_counts[i] > 0){
+			--m_counts[i];
+			m_bit.add(i, -1);
+			--m_size;
+			return true;
+		}
+		if(pending_rank(x, true) == pending_rank(x, false)){ return false; }
+		int a, b;
+		split(m_root, x, a, b);
+		m_root = merge(a, remove_min(b));
+		--m_size;
+		return true;
+	}
+
+	/**
+	 *  @brief 要素の計数
+	 *  @param[in] x  数える値
+	 *  @return    xが含まれている個数
+	 */
+	int count(ll x) const {
+		const int i = index_of(x);
+		const int pending = pending_rank(x, true) - pending_rank(x, false);
+		return (i >= 0 ? m_counts[i] : 0) + pending;
+	}
+
+	/**
+	 *  @brief 順位の計算
+	 *
+	 *  xより小さい要素の個数を求める。
+	 *
+	 *  @param[in] x  基準とする値
+	 *  @return    xより小さい要素の個数
+	 */
+	int rank(ll x) const {
+		const int i = lower_bound(m_keys.begin(), m_keys.end(), x) - m_keys.begin();
+		return m_bit.sum(i) + pending_rank(x, false);
+	}
+
+	/**
+	 *  @brief k番目の要素の取得
+	 *
+	 *  小さい方から数えてk番目 (0-indexed) の要素を求める。
+	 *
+	 *  @param[in] k  取得する要素の順位 (0 <= k < size())
+	 *  @return    k番目の要素
+	 */
+	ll kth(int k) const {
+		assert(0 <= k && k < static_cast<int>(m_size));
+		const int p = node_size(m_root);
+		const int m = static_cast<int>(m_size) - p;
+		// 小さい方から k+1 個のうち保留領域から取る個数 j を二分探索する
+		int lo = max(0, k + 1 - m), hi = min(p, k + 1);
+		const int upper = hi;
+		while(lo < hi){
+			const int j = lo + (hi - lo) / 2;
+			if(j < upper && pending_kth(j) < main_kth(k - j)){
+				lo = j + 1;
+			}else{
+				hi = j;
+			}
+		}
+		const int j = lo;
+		if(j == 0){ return main_kth(k); }
+		if(k + 1 - j == 0){ return pending_kth(j - 1); }
+		return max(pending_kth(j - 1), main_kth(k - j));
+	}
+
+};
+
+/**
+ *  @brief  スライド窓上のパーセンタイル
+ *
+ *  直近 window 個のサンプルについてのパーセンタイルを求める。
+ *  サンプルは固定長のリングバッファに保持する。
+ */
+class SlidingPercentile {
+
+private:
+	OrderStatisticsMultiset m_set;
+	vector<ll> m_window;
+	size_t m_capacity;
+	size_t m_head;
+
+public:
+	/**
+	 *  @brief コンストラクタ
+	 *  @param[in] window  窓の大きさ
+	 */
+	explicit SlidingPercentile(size_t window) :
+		m_set(), m_window(), m_capacity(window), m_head(0)
+	{
+		assert(window > 0);
+		m_window.reserve(window);
+	}
+
+	/**
+	 *  @brief 窓に含まれるサンプル数の取得
+	 *  @return 窓に含まれるサンプル数
+	 */
+	size_t size() const { return m_set.size(); }
+
+	/**
+	 *  @brief サンプルの追加
+	 *
+	 *  窓がすでに埋まっている場合は最も古いサンプルを取り除く。
+	 *
+	 *  @param[in] x  追加するサンプル
+	 */
+	void push(ll x){
+		if(m_window.size() < m_capacity){
+			m_window.push_back(x);
+		}else{
+			m_set.erase(m_window[m_head]);
+			m_window[m_head] = x;
+			m_head = (m_head + 1) % m_window.size();
+		}
+		m_set.insert(x);
+	}
+
+	/**
+	 *  @brief パーセンタイルの取得
+	 *
+	 *  窓に含まれるサンプルを昇順に並べたときの
+	 *  \f$ \lfloor q (n - 1) \rfloor \f$ 番目 (0-indexed) の値を返す。
+	 *
+	 *  @param[in] q  求める分位 (0 <= q <= 1)
+	 *  @return    パーセンタイル値
+	 */
+	ll percentile(double q) const {
+		assert(!m_window.empty());
+		const int n = m_set.size();
+		int k = static_cast<int>(q * (n - 1));
+		k = max(0, min(n - 1, k));
+		return m_set.kth(k);
+	}
+
+	/**
+	 *  @brief 中央値の取得
+	 *  @return 窓に含まれるサンプルの中央値 (下側)
+	 */
+	ll median() const { return percentile(0.5); }
+
+};
+
+/**
+ *  @}
+ */
+
+}
+}
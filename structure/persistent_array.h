@@ -0,0 +1,163 @@
+/**
+ *  @file structure/persistent_array.h
+ */
+#pragma once
+#include <vector>
+#include <iterator>
+#include "common/header.h"
+
+namespace libcomp {
+namespace structure {
+
+/**
+ *  @defgroup persistent_array Persistent array
+ *  @ingroup  structure
+ *  @{
+ */
+
+/**
+ *  @brief  経路コピーによる永続配列
+ *
+ *  完全二分木の葉に要素を持ち、更新時には根から葉までの経路のみを複製する。
+ *  すべてのノードは1つの連続した領域 (アリーナ) に確保され、
+ *  各バージョンは根のノード番号で表される。
+ *  過去のバージョンはすべて読み出し・更新可能なまま残る。
+ *
+ *  @tparam T  要素の型
+ */
+template <typename T>
+class PersistentArray {
+
+private:
+	struct Node {
+		int left;
+		int right;
+		T value;
+	};
+
+	vector<Node> m_nodes;
+	size_t m_size;
+
+	int create(int left, int right, const T &value){
+		Node node;
+		node.left = left;
+		node.right = right;
+		node.value = value;
+		m_nodes.push_back(node);
+		return static_cast<int>(m_nodes.size()) - 1;
+	}
+
+	template <typename Iterator>
+	int build(size_t width, Iterator &it, size_t &rest, const T &fill){
+		if(width == 1){
+			if(rest == 0){ return create(-1, -1, fill); }
+			--rest;
+			return create(-1, -1, *(it++));
+		}
+		const int l = build(width / 2, it, rest, fill);
+		const int r = build(width / 2, it, rest, fill);
+		return create(l, r, fill);
+	}
+
+public:
+	/**
+	 *  @brief コンストラクタ (既定値で初期化)
+	 *
+	 *  すべての要素がvalueである初期バージョン (バージョン番号は initial())
+	 *  を構築する。計算量は \f$ \mathcal{O}(n) \f$。
+	 *
+	 *  @param[in] n      配列の要素数
+	 *  @param[in] value  初期値
+	 */
+	explicit PersistentArray(size_t n = 0, const T &value = T()) :
+		m_nodes(), m_size(1)
+	{
+		while(m_size < n){ m_size *= 2; }
+		m_nodes.reserve(m_size * 2);
+		const T *dummy = NULL;
+		size_t rest = 0;
+		build(m_size, dummy, rest, value);
+	}
+
+	/**
+	 *  @brief コンストラクタ (要素列による初期化)
+	 *
+	 *  [first, last) を要素とする初期バージョンを構築する。
+	 *  計算量は \f$ \mathcal{O}(n) \f$。
+	 *
+	 *  @param[in] first  要素列の先頭を指すイテレータ
+	 *  @param[in] last   要素列の終端を指すイテレータ
+	 */
+	template <typename Iterator>
+	PersistentArray(Iterator first, Iterator last) :
+		m_nodes(), m_size(1)
+	{
+		size_t rest = distance(first, last);
+		while(m_size < rest){ m_size *= 2; }
+		m_nodes.reserve(m_size * 2);
+		build(m_size, first, rest, T());
+	}
+
+	/**
+	 *  @brief 初期バージョンの取得
+	 *  @return 初期バージョンを示すバージョン番号
+	 */
+	int initial() const { return static_cast<int>(m_size) * 2 - 2; }
+
+	/**
+	 *  @brief 要素の取得
+	 *
+	 *  バージョンversionにおけるi番目の要素を取得する。
+	 *  計算量は \f$ \mathcal{O}(\log{n}) \f$。
+	 *
+	 *  @param[in] version  バージョン番号
+	 *  @param[in] i        要素のインデックス
+	 *  @return    取得された値
+	 */
+	const T &get(int version, size_t i) const {
+		int k = version;
+		for(size_t bit = m_size >> 1; bit > 0; bit >>= 1){
+			k = (i & bit) ? m_nodes[k].right : m_nodes[k].left;
+		}
+		return m_nodes[k].value;
+	}
+
+	/**
+	 *  @brief 要素の更新
+	 *
+	 *  バージョンversionのi番目の要素をxに置き換えた新しいバージョンを作る。
+	 *  versionそのものは変更されない。
+	 *  計算量は \f$ \mathcal{O}(\log{n}) \f$ (時間・空間とも)。
+	 *
+	 *  @param[in] version  更新元のバージョン番号
+	 *  @param[in] i        更新する要素のインデックス
+	 *  @param[in] x        更新後の値
+	 *  @return    新しいバージョンのバージョン番号
+	 */
+	int set(int version, size_t i, const T &x){
+		const int root = create(
+			m_nodes[version].left, m_nodes[version].right, m_nodes[version].value);
+		int k = root;
+		for(size_t bit = m_size >> 1; bit > 0; bit >>= 1){
+			const int child = (i & bit) ? m_nodes[k].right : m_nodes[k].left;
+			const int copied = create(
+				m_nodes[child].left, m_nodes[child].right, m_nodes[child].value);
+			if(i & bit){
+				m_nodes[k].right = copied;
+			}else{
+				m_nodes[k].left = copied;
+			}
+			k = copied;
+		}
+		m_nodes[k].value = x;
+		return root;
+	}
+
+};
+
+/**
+ *  @}
+ */
+
+}
+}
@@ -0,0 +1,130 @@
+/**
+ *  @file structure/persistent_union_find_tree.h
+ */
+#pragma once
+#include <algorithm>
+#include "common/header.h"
+#include "structure/persistent_array.h"
+
+namespace libcomp {
+namespace structure {
+
+/**
+ *  @defgroup persistent_union_find_tree Persistent union-find tree
+ *  @ingroup  structure
+ *  @{
+ */
+
+/**
+ *  @brief 永続Union-Find木
+ *
+ *  PersistentArray 上に構築したUnion-Find木。
+ *  経路圧縮は行わず、要素数による併合 (union by size) によって
+ *  木の高さを \f$ \mathcal{O}(\log{n}) \f$ に抑える。
+ *  各バージョンは整数のバージョン番号で表され、すべて参照可能なまま残る。
+ */
+class PersistentUnionFindTree {
+
+private:
+	// 根ならば -(集合の要素数)、そうでなければ親のインデックス
+	PersistentArray<int> m_data;
+
+public:
+	/**
+	 *  @brief コンストラクタ
+	 *
+	 *  全要素が独立な状態の初期バージョン (initial()) を構築する。
+	 *
+	 *  @param[in] n  Union-Find木の要素数
+	 */
+	explicit PersistentUnionFindTree(int n = 0) :
+		m_data(static_cast<size_t>(n), -1)
+	{ }
+
+	/**
+	 *  @brief 初期バージョンの取得
+	 *  @return 全要素が独立な状態を示すバージョン番号
+	 */
+	int initial() const { return m_data.initial(); }
+
+	/**
+	 *  @brief 要素の属する集合のインデックスを取得
+	 *
+	 *  バージョンversionにおいて要素xの属している集合を示す値を取得する。
+	 *  計算量は \f$ \mathcal{O}(\log^2{n}) \f$。
+	 *
+	 *  @param[in] version  バージョン番号
+	 *  @param[in] x        対象とする要素のインデックス
+	 *  @return    要素xが属する集合を示すインデックス
+	 */
+	int find(int version, int x) const {
+		while(true){
+			const int p = m_data.get(version, x);
+			if(p < 0){ return x; }
+			x = p;
+		}
+	}
+
+	/**
+	 *  @brief 集合の要素数の取得
+	 *
+	 *  バージョンversionにおいて要素xの属している集合の要素数を求める。
+	 *  計算量は \f$ \mathcal{O}(\log^2{n}) \f$。
+	 *
+	 *  @param[in] version  バージョン番号
+	 *  @param[in] x        対象とする要素のインデックス
+	 *  @return    要素xが属する集合の要素数
+	 */
+	int size(int version, int x) const {
+		return -m_data.get(version, find(version, x));
+	}
+
+	/**
+	 *  @brief 2つの集合を併合する
+	 *
+	 *  バージョンversionにおいて要素xの属する集合と要素yの属する集合を
+	 *  併合した新しいバージョンを作る。versionそのものは変更されない。
+	 *  計算量は \f$ \mathcal{O}(\log^2{n}) \f$。
+	 *
+	 *  @param[in] version  併合元のバージョン番号
+	 *  @param[in] x        片方の集合に含まれる要素
+	 *  @param[in] y        他方の集合に含まれる要素
+	 *  @return    併合後のバージョン番号 (すでに同じ集合なら version)
+	 */
+	int unite(int version, int x, int y){
+		x = find(version, x);
+		y = find(version, y);
+		if(x == y){ return version; }
+		int sx = m_data.get(version, x), sy = m_data.get(version, y);
+		if(sx > sy){
+			swap(x, y);
+			swap(sx, sy);
+		}
+		const int next = m_data.set(version, x, sx + sy);
+		return m_data.set(next, y, x);
+	}
+
+	/**
+	 *  @brief 2つの要素が同じ集合に属しているかの判定
+	 *
+	 *  バージョンversionにおいて要素xと要素yが同じ集合に属しているかを判定する。
+	 *  計算量は \f$ \mathcal{O}(\log^2{n}) \f$。
+	 *
+	 *  @param[in] version  バージョン番号
+	 *  @param[in] x        片方の要素
+	 *  @param[in] y        他方の要素
+	 *  @retval    true     xとyが同じ集合に属している
+	 *  @retval    false    xとyが同じ集合に属していない
+	 */
+	bool same(int version, int x, int y) const {
+		return find(version, x) == find(version, y);
+	}
+
+};
+
+/**
+ *  @}
+ */
+
+}
+}
@@ -0,0 +1,124 @@
+/**
+ *  @file structure/pool_allocator.h
+ */
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <new>
+#include "common/header.h"
+
+namespace libcomp {
+namespace structure {
+
+/**
+ *  @defgroup pool_allocator Pool allocator
+ *  @ingroup  structure
+ *  @{
+ */
+
+/**
+ *  @brief  単一要素の確保に特化したプールアロケータ
+ *
+ *  std::map や std::set などのノードベースのコンテナに渡して用いる。
+ *  1要素ずつの確保はチャンク単位でまとめて確保した領域から切り出し、
+ *  解放された領域はフリーリストに繋いで再利用する。
+ *  プールは型ごとに1つだけ存在し、チャンクはプログラム終了まで解放されない。
+ *  スレッドセーフではない。
+ *
+ *  @tparam T  確保する要素の型
+ */
+template <typename T>
+class PoolAllocator {
+
+private:
+	union Block {
+		Block *next;
+		alignas(T) unsigned char storage[sizeof(T)];
+	};
+
+	static const size_t CHUNK_SIZE = 4096;
+
+	struct Pool {
+		vector<Block *> chunks;
+		Block *free_list;
+		size_t rest;
+
+		Pool() : chunks(), free_list(NULL), rest(0) { }
+
+		Block *allocate(){
+			if(free_list){
+				Block *b = free_list;
+				free_list = b->next;
+				return b;
+			}
+			if(rest == 0){
+				chunks.push_back(new Block[CHUNK_SIZE]);
+				rest = CHUNK_SIZE;
+			}
+			return chunks.back() + (--rest);
+		}
+
+		void deallocate(Block *b){
+			b->next = free_list;
+			free_list = b;
+		}
+	};
+
+	static Pool &pool(){
+		// 静的オブジェクトの破棄順序に依存しないよう、意図的に解放しない
+		static Pool *p = new Pool();
+		return *p;
+	}
+
+public:
+	/// 要素型
+	typedef T value_type;
+
+	/// 他の型に対するアロケータ
+	template <typename U>
+	struct rebind { typedef PoolAllocator<U> other; };
+
+	/// デフォルトコンストラクタ
+	PoolAllocator(){ }
+	/// 他の型のアロケータからの変換
+	template <typename U>
+	PoolAllocator(const PoolAllocator<U> &){ }
+
+	/**
+	 *  @brief 領域の確保
+	 *  @param[in] n  確保する要素数
+	 *  @return    確保された領域の先頭
+	 */
+	T *allocate(size_t n){
+		if(n != 1){ return static_cast<T *>(::operator new(n * sizeof(T))); }
+		return reinterpret_cast<T *>(pool().allocate());
+	}
+
+	/**
+	 *  @brief 領域の解放
+	 *  @param[in] p  解放する領域の先頭
+	 *  @param[in] n  解放する要素数
+	 */
+	void deallocate(T *p, size_t n){
+		if(n != 1){
+			::operator delete(p);
+			return;
+		}
+		pool().deallocate(reinterpret_cast<Block *>(p));
+	}
+
+	/// アロケータ同士の比較 (常に等しい)
+	template <typename U>
+	bool operator==(const PoolAllocator<U> &) const { return true; }
+	/// アロケータ同士の比較 (常に等しい)
+	template <typename U>
+	bool operator!=(const PoolAllocator<U> &) const { return false; }
+
+};
+
+/**
+ *  @}
+ */
+
+}
+}
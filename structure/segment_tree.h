@@ -5,6 +5,10 @@
 #include <vector>
 #include <algorithm>
 #include <iterator>
+#include <typeinfo>
+#include <type_traits>
+#include <cstdio>
+#include <cstring>
 #include "common/header.h"
 
 namespace libcomp {
@@ -16,6 +20,84 @@ namespace structure {
  *  @{
  */
 
+template <typename Traits> class MappedSegmentTree;
+
+/**
+ *  @brief セグメント木のスナップショットのヘッダ
+ *
+ *  SegmentTree::save で書き出されるファイルの先頭に置かれる。
+ *  節点の配列はこのヘッダの直後から始まる。
+ */
+struct SegmentTreeImageHeader {
+	/// 現在のフォーマットのバージョン
+	static const unsigned int CURRENT_VERSION = 1;
+
+	/// マジックナンバー ("LCSEGTRE")
+	char magic[8];
+	/// フォーマットのバージョン
+	unsigned int version;
+	/// 値型の大きさ
+	unsigned int value_size;
+	/// 葉の数 (2のべき乗)
+	ull leaves;
+	/// Traitsの型から求めたフィンガープリント
+	ull fingerprint;
+	/// 予約領域 (ヘッダを64バイトに揃える)
+	ull reserved[4];
+
+	/**
+	 *  @brief Traitsのフィンガープリントの計算
+	 *
+	 *  Traitsの型名と値型の大きさからFNV-1aハッシュを求める。
+	 *  同じコンパイラで生成されたバイナリ間でのみ一致が保証される。
+	 *
+	 *  @tparam Traits  セグメント木の動作を示す型
+	 *  @return フィンガープリント
+	 */
+	template <typename Traits>
+	static ull fingerprint_of(){
+		ull h = 14695981039346656037ull;
+		for(const char *p = typeid(Traits).name(); *p; ++p){
+			h = (h ^ static_cast<unsigned char>(*p)) * 1099511628211ull;
+		}
+		h = (h ^ sizeof(typename Traits::value_type)) * 1099511628211ull;
+		return h;
+	}
+
+	/**
+	 *  @brief ヘッダの生成
+	 *  @tparam    Traits  セグメント木の動作を示す型
+	 *  @param[in] leaves  葉の数
+	 *  @return    生成されたヘッダ
+	 */
+	template <typename Traits>
+	static SegmentTreeImageHeader create(ull leaves){
+		SegmentTreeImageHeader header;
+		memset(&header, 0, sizeof(header));
+		memcpy(header.magic, "LCSEGTRE", 8);
+		header.version = CURRENT_VERSION;
+		header.value_size = sizeof(typename Traits::value_type);
+		header.leaves = leaves;
+		header.fingerprint = fingerprint_of<Traits>();
+		return header;
+	}
+
+	/**
+	 *  @brief ヘッダの検証
+	 *  @tparam    Traits  セグメント木の動作を示す型
+	 *  @retval    true    ヘッダがTraitsによるスナップショットを示している
+	 *  @retval    false   ヘッダが不正であるかTraitsが一致しない
+	 */
+	template <typename Traits>
+	bool validate() const {
+		if(memcmp(magic, "LCSEGTRE", 8) != 0){ return false; }
+		if(version != CURRENT_VERSION){ return false; }
+		if(value_size != sizeof(typename Traits::value_type)){ return false; }
+		if(leaves == 0 || (leaves & (leaves - 1)) != 0){ return false; }
+		return fingerprint == fingerprint_of<Traits>();
+	}
+};
+
 /**
  *  @brief  セグメント木
  *  @sa MinSegmentTreeTraits
@@ -132,6 +214,51 @@ public:
 		return m_data[m_size - 1 + i];
 	}
 
+	/**
+	 *  @brief スナップショットの保存
+	 *
+	 *  構築済みの節点の配列を SegmentTreeImageHeader に続けてファイルに書き出す。
+	 *  値型はtrivially copyableである必要がある。
+	 *  計算量は \f$ \mathcal{O}(n) \f$。
+	 *
+	 *  @param[in] path   出力先のファイル名
+	 *  @retval    true   書き出しに成功した
+	 *  @retval    false  書き出しに失敗した
+	 */
+	bool save(const char *path) const {
+		static_assert(
+			is_trivially_copyable<value_type>::value,
+			"value_type must be trivially copyable");
+		const SegmentTreeImageHeader header =
+			SegmentTreeImageHeader::create<Traits>(m_size);
+		FILE *fp = fopen(path, "wb");
+		if(!fp){ return false; }
+		bool result = fwrite(&header, sizeof(header), 1, fp) == 1;
+		if(result){
+			result = fwrite(
+				&m_data[0], sizeof(value_type), m_data.size(), fp) == m_data.size();
+		}
+		return fclose(fp) == 0 && result;
+	}
+
+	/**
+	 *  @brief スナップショットのメモリマップ
+	 *
+	 *  save で書き出されたファイルを読み取り専用でメモリにマップし、
+	 *  その上で直接問い合わせを行うセグメント木を返す。
+	 *  再構築は行わないため、計算量は \f$ \mathcal{O}(1) \f$ (ページフォルトを除く)。
+	 *  利用には structure/mapped_segment_tree.h のインクルードが必要。
+	 *
+	 *  @param[in] path    マップするファイル名
+	 *  @param[in] traits  処理内容を示す関数オブジェクト
+	 *  @return    マップされたセグメント木。失敗した場合は is_open() が false となる。
+	 */
+	static MappedSegmentTree<Traits> map(
+		const char *path, const Traits &traits = Traits())
+	{
+		return MappedSegmentTree<Traits>(path, traits);
+	}
+
 };
 
 /**
@@ -0,0 +1,220 @@
+/**
+ *  @file structure/segment_tree_bundle.h
+ */
+#pragma once
+#include <vector>
+#include <algorithm>
+#include "common/header.h"
+
+namespace libcomp {
+namespace structure {
+
+/**
+ *  @addtogroup segment_tree
+ *  @{
+ */
+
+/**
+ *  @brief  同じ大きさのセグメント木K本の束
+ *
+ *  K本のセグメント木の同じ節点をメモリ上で連続するように
+ *  インターリーブして格納する。
+ *  全ての木に対する問い合わせは1回の走査で処理され、
+ *  レーン方向の内側ループはコンパイラによるベクトル化の対象となる。
+ *
+ *  @sa SegmentTree
+ *  @tparam Traits  セグメント木の動作を示す型
+ *  @tparam K       束ねる木の本数
+ */
+template <typename Traits, int K>
+class SegmentTreeBundle {
+
+public:
+	/// 値型
+	typedef typename Traits::value_type value_type;
+
+private:
+	Traits m_traits;
+	vector<value_type> m_data;
+	size_t m_size;
+
+	value_type *node(size_t k){ return &m_data[k * K]; }
+	const value_type *node(size_t k) const { return &m_data[k * K]; }
+
+	void initialize(){
+		for(size_t k = m_size - 1; k > 0; --k){
+			value_type *p = node(k);
+			const value_type *l = node(k * 2), *r = node(k * 2 + 1);
+			for(int j = 0; j < K; ++j){ p[j] = m_traits(l[j], r[j]); }
+		}
+	}
+
+public:
+	/**
+	 *  @brief コンストラクタ (既定値で初期化)
+	 *
+	 *  全ての木の葉をすべて既定値で初期化した状態の束を構築する。
+	 *  計算量は \f$ \mathcal{O}(nK) \f$。
+	 *
+	 *  @param[in] size    各木に最低限必要な葉の数
+	 *  @param[in] traits  処理内容を示す関数オブジェクト
+	 */
+	explicit SegmentTreeBundle(
+		size_t size = 0, const Traits &traits = Traits()) :
+		m_traits(traits), m_data(), m_size(1)
+	{
+		while(m_size < size){ m_size *= 2; }
+		m_data.assign(m_size * 2 * K, m_traits.default_value());
+		initialize();
+	}
+
+	/**
+	 *  @brief コンストラクタ (要素列による初期化)
+	 *
+	 *  lane番目の木の葉を firsts[lane] から始まる n 要素で初期化する。
+	 *  計算量は \f$ \mathcal{O}(nK) \f$。
+	 *
+	 *  @param[in] firsts  各木の要素列の先頭を指すイテレータの配列 (K要素)
+	 *  @param[in] n       各木の要素数
+	 *  @param[in] traits  処理内容を示す関数オブジェクト
+	 */
+	template <typename Iterator>
+	SegmentTreeBundle(
+		const Iterator *firsts, size_t n, const Traits &traits = Traits()) :
+		m_traits(traits), m_data(), m_size(1)
+	{
+		while(m_size < n){ m_size *= 2; }
+		m_data.assign(m_size * 2 * K, m_traits.default_value());
+		for(int j = 0; j < K; ++j){
+			Iterator it = firsts[j];
+			for(size_t i = 0; i < n; ++i, ++it){ node(m_size + i)[j] = *it; }
+		}
+		initialize();
+	}
+
+	/**
+	 *  @brief 葉の更新
+	 *
+	 *  lane番目の木のi番目の葉の値をvalで更新する。
+	 *  計算量は \f$ \mathcal{O}(\log{n}) \f$。
+	 *
+	 *  @param[in] lane  更新したい木の番号
+	 *  @param[in] i     更新したい葉のインデックス
+	 *  @param[in] val   更新後の値
+	 */
+	void update(int lane, size_t i, const value_type &val){
+		i += m_size;
+		node(i)[lane] = val;
+		for(i >>= 1; i > 0; i >>= 1){
+			node(i)[lane] =
+				m_traits(node(i * 2)[lane], node(i * 2 + 1)[lane]);
+		}
+	}
+
+	/**
+	 *  @brief 1本の木についての区間問い合わせ
+	 *
+	 *  lane番目の木について区間 [a, b) の要素すべてを結合した結果を求める。
+	 *  計算量は \f$ \mathcal{O}(\log{n}) \f$。
+	 *
+	 *  @param[in] lane  問い合わせる木の番号
+	 *  @param[in] a     区間の始端
+	 *  @param[in] b     区間の終端
+	 *  @return    計算された結果
+	 */
+	value_type query(int lane, size_t a, size_t b) const {
+		value_type vl = m_traits.default_value();
+		value_type vr = m_traits.default_value();
+		for(a += m_size, b += m_size; a < b; a >>= 1, b >>= 1){
+			if(a & 1){ vl = m_traits(vl, node(a++)[lane]); }
+			if(b & 1){ vr = m_traits(node(--b)[lane], vr); }
+		}
+		return m_traits(vl, vr);
+	}
+
+	/**
+	 *  @brief 全ての木についての同一区間の問い合わせ
+	 *
+	 *  すべての木について区間 [a, b) の要素を結合した結果を
+	 *  1回の走査で求め、out[lane] に書き込む。
+	 *  計算量は \f$ \mathcal{O}(K \log{n}) \f$。
+	 *
+	 *  @param[in]  a    区間の始端
+	 *  @param[in]  b    区間の終端
+	 *  @param[out] out  結果の出力先 (K要素)
+	 */
+	void query_all(size_t a, size_t b, value_type *out) const {
+		value_type vl[K], vr[K];
+		fill(vl, vl + K, m_traits.default_value());
+		fill(vr, vr + K, m_traits.default_value());
+		for(a += m_size, b += m_size; a < b; a >>= 1, b >>= 1){
+			if(a & 1){
+				const value_type *p = node(a++);
+				for(int j = 0; j < K; ++j){ vl[j] = m_traits(vl[j], p[j]); }
+			}
+			if(b & 1){
+				const value_type *p = node(--b);
+				for(int j = 0; j < K; ++j){ vr[j] = m_traits(p[j], vr[j]); }
+			}
+		}
+		for(int j = 0; j < K; ++j){ out[j] = m_traits(vl[j], vr[j]); }
+	}
+
+	/**
+	 *  @brief 木ごとに異なる区間の問い合わせ
+	 *
+	 *  lane番目の木について区間 [a[lane], b[lane]) の要素を結合した結果を
+	 *  out[lane] に書き込む。全てのレーンは同じ段数だけ木を登るため、
+	 *  分岐を含まない形でK個の問い合わせを同時に処理する。
+	 *  計算量は \f$ \mathcal{O}(K \log{n}) \f$。
+	 *
+	 *  @param[in]  a    各区間の始端 (K要素)
+	 *  @param[in]  b    各区間の終端 (K要素)
+	 *  @param[out] out  結果の出力先 (K要素)
+	 */
+	void query_each(const size_t *a, const size_t *b, value_type *out) const {
+		const value_type e = m_traits.default_value();
+		value_type vl[K], vr[K];
+		size_t l[K], r[K];
+		for(int j = 0; j < K; ++j){
+			vl[j] = vr[j] = e;
+			l[j] = a[j] + m_size;
+			r[j] = b[j] + m_size;
+		}
+		for(size_t w = m_size * 2; w > 1; w >>= 1){
+			for(int j = 0; j < K; ++j){
+				const bool active = l[j] < r[j];
+				const bool take_l = active && (l[j] & 1);
+				const bool take_r = active && (r[j] & 1);
+				const size_t rr = r[j] - take_r;
+				vl[j] = m_traits(vl[j], take_l ? m_data[l[j] * K + j] : e);
+				vr[j] = m_traits(take_r ? m_data[rr * K + j] : e, vr[j]);
+				l[j] = (l[j] + take_l) >> 1;
+				r[j] = rr >> 1;
+			}
+		}
+		for(int j = 0; j < K; ++j){ out[j] = m_traits(vl[j], vr[j]); }
+	}
+
+	/**
+	 *  @brief 葉の取得
+	 *
+	 *  lane番目の木のi番目の葉の値を取得する。
+	 *  計算量は \f$ \mathcal{O}(1) \f$。
+	 *
+	 *  @param[in] lane  取得する木の番号
+	 *  @param[in] i     取得する葉のインデックス
+	 *  @return    取得された値
+	 */
+	value_type operator()(int lane, size_t i) const {
+		return node(m_size + i)[lane];
+	}
+
+};
+
+/**
+ *  @}
+ */
+
+}
+}
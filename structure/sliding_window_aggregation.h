@@ -0,0 +1,280 @@
+/**
+ *  @file structure/sliding_window_aggregation.h
+ */
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <cassert>
+#include "common/header.h"
+
+namespace libcomp {
+namespace structure {
+
+/**
+ *  @defgroup sliding_window_aggregation Sliding window aggregation
+ *  @ingroup  structure
+ *  @{
+ */
+
+/**
+ *  @brief  2本のスタックによるスライド窓集約
+ *
+ *  末尾への追加と先頭からの削除を行いながら、
+ *  窓に含まれる要素列を先頭から順に結合した値を求める。
+ *  結合則を満たしていれば可換である必要はない。
+ *  2本のスタックは1本の可変長配列上に並べて格納する。
+ *
+ *  @sa MinSegmentTreeTraits
+ *  @tparam Traits  結合演算を示す型 (SegmentTree と共通)
+ */
+template <typename Traits>
+class SlidingWindowAggregation {
+
+public:
+	/// 値型
+	typedef typename Traits::value_type value_type;
+
+private:
+	Traits m_traits;
+	vector<value_type> m_data;
+	value_type m_back;
+	size_t m_head;
+	size_t m_mid;
+
+	void flip(){
+		m_data.erase(m_data.begin(), m_data.begin() + m_head);
+		m_head = 0;
+		m_mid = m_data.size();
+		for(int i = static_cast<int>(m_mid) - 2; i >= 0; --i){
+			m_data[i] = m_traits(m_data[i], m_data[i + 1]);
+		}
+		m_back = m_traits.default_value();
+	}
+
+public:
+	/**
+	 *  @brief コンストラクタ
+	 *
+	 *  要素が含まれない状態に初期化する。
+	 *
+	 *  @param[in] traits  処理内容を示す関数オブジェクト
+	 */
+	explicit SlidingWindowAggregation(const Traits &traits = Traits()) :
+		m_traits(traits), m_data(), m_back(m_traits.default_value()),
+		m_head(0), m_mid(0)
+	{ }
+
+	/**
+	 *  @brief 窓に含まれる要素数の取得
+	 *  @return 窓に含まれる要素数
+	 */
+	size_t size() const { return m_data.size() - m_head; }
+
+	/**
+	 *  @brief 窓が空であるかの判定
+	 *  @retval true   窓に要素が含まれていない
+	 *  @retval false  窓に要素が含まれている
+	 */
+	bool empty() const { return m_data.size() == m_head; }
+
+	/**
+	 *  @brief 集約値の取得
+	 *
+	 *  窓に含まれる要素すべてを先頭から順に結合した値を求める。
+	 *  計算量は \f$ \mathcal{O}(1) \f$。
+	 *
+	 *  @return 計算された結果
+	 */
+	value_type query() const {
+		if(m_head == m_mid){ return m_back; }
+		return m_traits(m_data[m_head], m_back);
+	}
+
+	/**
+	 *  @brief 窓の拡大
+	 *
+	 *  窓の末尾に要素を追加する。
+	 *  計算量は \f$ \mathcal{O}(1) \f$ (amortized)。
+	 *
+	 *  @param[in] x  窓に新たに追加される値
+	 */
+	void push(const value_type &x){
+		m_data.push_back(x);
+		m_back = m_traits(m_back, x);
+	}
+
+	/**
+	 *  @brief 窓の縮小
+	 *
+	 *  窓の先頭要素を取り除く。
+	 *  計算量は \f$ \mathcal{O}(1) \f$ (amortized)。
+	 */
+	void pop(){
+		assert(!empty());
+		if(m_head == m_mid){ flip(); }
+		++m_head;
+	}
+
+};
+
+/**
+ *  @brief  DABAによる最悪計算量保証付きスライド窓集約
+ *
+ *  SlidingWindowAggregation と同じ操作を、
+ *  De-Amortized Banker's Aggregator (DABA) によって
+ *  償却なしの \f$ \mathcal{O}(1) \f$ 回の結合演算で行う。
+ *  要素は2べきサイズのリングバッファに格納され、
+ *  容量を超えた場合にのみ再確保が発生する。
+ *  再確保を避けたい場合はコンストラクタで容量を指定する。
+ *
+ *  @tparam Traits  結合演算を示す型 (SegmentTree と共通)
+ */
+template <typename Traits>
+class DeamortizedSlidingWindowAggregation {
+
+public:
+	/// 値型
+	typedef typename Traits::value_type value_type;
+
+private:
+	struct Node {
+		value_type value;
+		value_type aggregate;
+	};
+
+	Traits m_traits;
+	vector<Node> m_data;
+	size_t m_mask;
+	// l_F = [F, L), l_L = [L, R), l_R = [R, A), l_A = [A, B), l_B = [B, E)
+	size_t m_f, m_l, m_r, m_a, m_b, m_e;
+
+	Node &at(size_t i){ return m_data[i & m_mask]; }
+	const Node &at(size_t i) const { return m_data[i & m_mask]; }
+
+	value_type aggregate_f() const {
+		return m_f == m_e ? m_traits.default_value() : at(m_f).aggregate;
+	}
+	value_type aggregate_b() const {
+		return m_b == m_e ? m_traits.default_value() : at(m_e - 1).aggregate;
+	}
+	value_type aggregate_l() const {
+		return m_l == m_r ? m_traits.default_value() : at(m_l).aggregate;
+	}
+	value_type aggregate_r() const {
+		return m_r == m_a ? m_traits.default_value() : at(m_a - 1).aggregate;
+	}
+	value_type aggregate_a() const {
+		return m_a == m_b ? m_traits.default_value() : at(m_a).aggregate;
+	}
+
+	void grow(){
+		const size_t size = m_data.size() * 2;
+		vector<Node> next(size);
+		for(size_t i = m_f; i != m_e; ++i){ next[i & (size - 1)] = at(i); }
+		m_data.swap(next);
+		m_mask = size - 1;
+	}
+
+	void fixup(){
+		if(m_f == m_b){
+			m_b = m_a = m_r = m_l = m_e;
+			return;
+		}
+		if(m_l == m_b){
+			m_l = m_f;
+			m_a = m_b = m_e;
+		}
+		if(m_l == m_r){
+			++m_a; ++m_r; ++m_l;
+		}else{
+			const value_type ra = m_traits(aggregate_r(), aggregate_a());
+			at(m_l).aggregate = m_traits(aggregate_l(), ra);
+			++m_l;
+			Node &node = at(m_a - 1);
+			node.aggregate = m_traits(node.value, aggregate_a());
+			--m_a;
+		}
+	}
+
+public:
+	/**
+	 *  @brief コンストラクタ
+	 *
+	 *  要素が含まれない状態に初期化する。
+	 *
+	 *  @param[in] capacity  あらかじめ確保しておく要素数
+	 *  @param[in] traits    処理内容を示す関数オブジェクト
+	 */
+	explicit DeamortizedSlidingWindowAggregation(
+		size_t capacity = 1, const Traits &traits = Traits()) :
+		m_traits(traits), m_data(), m_mask(0),
+		m_f(0), m_l(0), m_r(0), m_a(0), m_b(0), m_e(0)
+	{
+		size_t size = 1;
+		while(size < capacity){ size *= 2; }
+		m_data.resize(size);
+		m_mask = size - 1;
+	}
+
+	/**
+	 *  @brief 窓に含まれる要素数の取得
+	 *  @return 窓に含まれる要素数
+	 */
+	size_t size() const { return m_e - m_f; }
+
+	/**
+	 *  @brief 窓が空であるかの判定
+	 *  @retval true   窓に要素が含まれていない
+	 *  @retval false  窓に要素が含まれている
+	 */
+	bool empty() const { return m_e == m_f; }
+
+	/**
+	 *  @brief 集約値の取得
+	 *
+	 *  窓に含まれる要素すべてを先頭から順に結合した値を求める。
+	 *  計算量は \f$ \mathcal{O}(1) \f$。
+	 *
+	 *  @return 計算された結果
+	 */
+	value_type query() const {
+		return m_traits(aggregate_f(), aggregate_b());
+	}
+
+	/**
+	 *  @brief 窓の拡大
+	 *
+	 *  窓の末尾に要素を追加する。
+	 *  容量の範囲内であれば計算量は \f$ \mathcal{O}(1) \f$ (worst case)。
+	 *
+	 *  @param[in] x  窓に新たに追加される値
+	 */
+	void push(const value_type &x){
+		if(size() == m_data.size()){ grow(); }
+		Node &node = at(m_e);
+		node.aggregate = m_traits(aggregate_b(), x);
+		node.value = x;
+		++m_e;
+		fixup();
+	}
+
+	/**
+	 *  @brief 窓の縮小
+	 *
+	 *  窓の先頭要素を取り除く。
+	 *  計算量は \f$ \mathcal{O}(1) \f$ (worst case)。
+	 */
+	void pop(){
+		assert(!empty());
+		++m_f;
+		fixup();
+	}
+
+};
+
+/**
+ *  @}
+ */
+
+}
+}
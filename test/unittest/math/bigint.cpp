@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <sstream>
+#include "math/bigint.h"
+#include "../../utility/random.h"
+#include "../../utility/stopwatch.h"
+
+namespace {
+
+typedef libcomp::math::BigInt BigInt;
+
+string random_decimal(int n){
+	string s(n, '0');
+	for(int i = 0; i < n; ++i){ s[i] = '0' + testtool::random() % 10; }
+	if(s[0] == '0'){ s[0] = '1' + testtool::random() % 9; }
+	return s;
+}
+
+BigInt random_bigint(int n){
+	const string s = random_decimal(n);
+	return BigInt(testtool::random() % 2 ? "-" + s : s);
+}
+
+ll random_ll(){
+	const ll x = static_cast<ll>(
+		((static_cast<ull>(testtool::random()) << 32) | testtool::random()) >> (testtool::random() % 62 + 2));
+	return testtool::random() % 2 ? -x : x;
+}
+
+string int128_to_string(__int128 x){
+	if(x == 0){ return "0"; }
+	const bool negative = (x < 0);
+	unsigned __int128 y = (negative ? -static_cast<unsigned __int128>(x) : x);
+	string s;
+	for(; y > 0; y /= 10){ s += static_cast<char>('0' + y % 10); }
+	if(negative){ s += '-'; }
+	return string(s.rbegin(), s.rend());
+}
+
+string naive_multiply(const string &a, const string &b){
+	vector<ull> c(a.size() + b.size());
+	for(size_t i = 0; i < a.size(); ++i){
+		for(size_t j = 0; j < b.size(); ++j){
+			c[i + j] += (a[a.size() - 1 - i] - '0') * (b[b.size() - 1 - j] - '0');
+		}
+	}
+	for(size_t i = 0; i + 1 < c.size(); ++i){
+		c[i + 1] += c[i] / 10;
+		c[i] %= 10;
+	}
+	string s;
+	for(size_t i = c.size(); i > 0; --i){
+		if(!s.empty() || c[i - 1] != 0){ s += static_cast<char>('0' + c[i - 1]); }
+	}
+	return s.empty() ? "0" : s;
+}
+
+}
+
+TEST(MathBigInt, TestSmall){
+	for(int t = 0; t < 10000; ++t){
+		const ll a = random_ll(), b = random_ll();
+		const BigInt x(a), y(b);
+		EXPECT_EQ(int128_to_string(a), x.to_string());
+		EXPECT_EQ(int128_to_string(static_cast<__int128>(a) + b), (x + y).to_string());
+		EXPECT_EQ(int128_to_string(static_cast<__int128>(a) - b), (x - y).to_string());
+		EXPECT_EQ(int128_to_string(static_cast<__int128>(a) * b), (x * y).to_string());
+		if(b != 0){
+			EXPECT_EQ(BigInt(a / b), x / y);
+			EXPECT_EQ(BigInt(a % b), x % y);
+		}
+		EXPECT_EQ(a < b, x < y);
+		EXPECT_EQ(a <= b, x <= y);
+		EXPECT_EQ(a > b, x > y);
+		EXPECT_EQ(a >= b, x >= y);
+		EXPECT_EQ(a == b, x == y);
+		EXPECT_EQ(a != b, x != y);
+	}
+	EXPECT_EQ("-9223372036854775808", BigInt(-9223372036854775807ll - 1).to_string());
+	EXPECT_EQ(0, (BigInt(5) - BigInt(5)).sign());
+	EXPECT_EQ(BigInt(0), -BigInt(0));
+}
+
+TEST(MathBigInt, TestString){
+	EXPECT_EQ("0", BigInt("0").to_string());
+	EXPECT_EQ("0", BigInt("-000").to_string());
+	EXPECT_EQ("12", BigInt("+12").to_string());
+	EXPECT_EQ("123", BigInt("000123").to_string());
+	EXPECT_EQ("-1000000000", BigInt("-1000000000").to_string());
+	for(int t = 0; t < 200; ++t){
+		const int n = testtool::random() % (t < 150 ? 300 : 30000) + 1;
+		const string s = (t % 2 ? "-" : "") + random_decimal(n);
+		EXPECT_EQ(s, BigInt(s).to_string());
+	}
+	std::ostringstream oss;
+	oss << BigInt("-31415926535897932384626433832795028841971");
+	EXPECT_EQ("-31415926535897932384626433832795028841971", oss.str());
+}
+
+TEST(MathBigInt, TestMultiply){
+	// 筆算、Karatsuba法、数論変換のそれぞれを通る大きさ
+	const int sizes[][2] = {
+		{ 1, 1 }, { 20, 300 }, { 400, 400 }, { 1000, 3000 },
+		{ 3000, 3000 }, { 4500, 4500 }, { 300, 8000 }, { 11000, 10500 }
+	};
+	for(const auto &size : sizes){
+		const string a = random_decimal(size[0]), b = random_decimal(size[1]);
+		const string expected = naive_multiply(a, b);
+		EXPECT_EQ(expected, (BigInt(a) * BigInt(b)).to_string());
+		EXPECT_EQ("-" + expected, (BigInt("-" + a) * BigInt(b)).to_string());
+	}
+	// すべての桁が 2^32 - 1 の場合
+	for(int k = 1; k <= 5000; k *= 4){
+		BigInt p(1);
+		for(int i = 0; i < k; ++i){ p *= BigInt(1ll << 32); }
+		const BigInt x = p - BigInt(1);
+		EXPECT_EQ(p * p - BigInt(2) * p + BigInt(1), x * x);
+	}
+}
+
+TEST(MathBigInt, TestDivide){
+	for(int t = 0; t < 300; ++t){
+		const int n = testtool::random() % (t < 200 ? 500 : 20000) + 1;
+		const int m = testtool::random() % (n + 20) + 1;
+		const BigInt a = random_bigint(n), b = random_bigint(m);
+		const BigInt q = a / b, r = a % b;
+		EXPECT_EQ(a, q * b + r);
+		EXPECT_TRUE(r.sign() == 0 || r.sign() == a.sign());
+		EXPECT_LT(r.sign() >= 0 ? r : -r, b.sign() >= 0 ? b : -b);
+	}
+	for(int t = 0; t < 20; ++t){
+		const BigInt a = random_bigint(testtool::random() % 10000 + 1);
+		const BigInt b = random_bigint(testtool::random() % 10000 + 1);
+		EXPECT_EQ(a, (a * b) / b);
+		EXPECT_EQ(BigInt(0), (a * b) % b);
+	}
+	// 2^{32k} と 2^{32k} - 1 による除算
+	for(int k = 1; k <= 2000; k *= 3){
+		BigInt p(1);
+		for(int i = 0; i < k; ++i){ p *= BigInt(1ll << 32); }
+		const BigInt x = p - BigInt(1);
+		EXPECT_EQ(x, (p * p - BigInt(1)) / p);
+		EXPECT_EQ(p + BigInt(1), (p * p - BigInt(1)) / x);
+		EXPECT_EQ(x, (p * p - BigInt(1)) / (p + BigInt(1)));
+		EXPECT_EQ(BigInt(1), p * p % (p + BigInt(1)));
+	}
+}
+
+TEST(MathBigInt, TestPerformance){
+	const int N = 100000;
+	const string s = random_decimal(N), t = random_decimal(N);
+	testtool::StopWatch stopwatch;
+	const BigInt a(s), b(t);
+	const BigInt c = a * b;
+	EXPECT_EQ(a, c / b);
+	const string u = c.to_string();
+	ASSERT_LE(stopwatch.get(), 3000u);
+	EXPECT_GE(static_cast<int>(u.size()), 2 * N - 1);
+	EXPECT_LE(static_cast<int>(u.size()), 2 * N);
+	EXPECT_EQ(s, a.to_string());
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "math/binary_matrix.h"
+#include "../../utility/random.h"
+#include "../../utility/stopwatch.h"
+
+namespace {
+
+int naive_rank(vector< vector<int> > a){
+	const int n = a.size(), m = n ? a[0].size() : 0;
+	int r = 0;
+	for(int c = 0; c < m && r < n; ++c){
+		int p = r;
+		while(p < n && !a[p][c]){ ++p; }
+		if(p == n){ continue; }
+		swap(a[p], a[r]);
+		for(int i = 0; i < n; ++i){
+			if(i == r || !a[i][c]){ continue; }
+			for(int j = c; j < m; ++j){ a[i][j] ^= a[r][j]; }
+		}
+		++r;
+	}
+	return r;
+}
+
+vector< vector<int> > random_bits(int n, int m, int density){
+	vector< vector<int> > a(n, vector<int>(m));
+	for(int i = 0; i < n; ++i){
+		for(int j = 0; j < m; ++j){ a[i][j] = static_cast<int>(testtool::random() % 100) < density; }
+	}
+	return a;
+}
+
+libcomp::math::BinaryMatrix to_binary_matrix(const vector< vector<int> > &a, int m){
+	libcomp::math::BinaryMatrix b(a.size(), m);
+	for(size_t i = 0; i < a.size(); ++i){
+		for(int j = 0; j < m; ++j){ b.set(i, j, a[i][j]); }
+	}
+	return b;
+}
+
+}
+
+TEST(MathBinaryMatrix, TestRank){
+	for(int t = 0; t < 200; ++t){
+		const int n = testtool::random() % 150 + 1;
+		const int m = testtool::random() % 150 + 1;
+		const vector< vector<int> > a = random_bits(n, m, testtool::random() % 100);
+		const libcomp::math::BinaryMatrix b = to_binary_matrix(a, m);
+		for(int i = 0; i < n; ++i){
+			for(int j = 0; j < m; ++j){ ASSERT_EQ(a[i][j], b.get(i, j)); }
+		}
+		EXPECT_EQ(naive_rank(a), b.rank());
+	}
+}
+
+TEST(MathBinaryMatrix, TestEliminate){
+	const int n = 90, m = 140;
+	const vector< vector<int> > a = random_bits(n, m, 5);
+	libcomp::math::BinaryMatrix b = to_binary_matrix(a, m);
+	vector<int> pivots;
+	const int r = b.eliminate(&pivots);
+	ASSERT_EQ(naive_rank(a), r);
+	ASSERT_EQ(r, static_cast<int>(pivots.size()));
+	for(int i = 0; i < r; ++i){
+		if(i > 0){ EXPECT_LT(pivots[i - 1], pivots[i]); }
+		for(int k = 0; k < n; ++k){ EXPECT_EQ(k == i ? 1 : 0, b.get(k, pivots[i])); }
+	}
+	for(int i = r; i < n; ++i){
+		for(int j = 0; j < m; ++j){ EXPECT_EQ(0, b.get(i, j)); }
+	}
+}
+
+TEST(MathBinaryMatrix, TestSolve){
+	for(int t = 0; t < 200; ++t){
+		const int n = testtool::random() % 100 + 1;
+		const int m = testtool::random() % 100 + 1;
+		const vector< vector<int> > a = random_bits(n, m, testtool::random() % 100);
+		vector<int> b(n);
+		for(int i = 0; i < n; ++i){ b[i] = testtool::random() % 2; }
+		vector< vector<int> > augmented = a;
+		for(int i = 0; i < n; ++i){ augmented[i].push_back(b[i]); }
+		const bool solvable = naive_rank(a) == naive_rank(augmented);
+		const vector<int> x = to_binary_matrix(a, m).solve(b);
+		if(!solvable){
+			EXPECT_TRUE(x.empty());
+			continue;
+		}
+		ASSERT_EQ(m, static_cast<int>(x.size()));
+		for(int i = 0; i < n; ++i){
+			int s = 0;
+			for(int j = 0; j < m; ++j){ s ^= a[i][j] & x[j]; }
+			EXPECT_EQ(b[i], s);
+		}
+	}
+}
+
+TEST(MathBinaryMatrix, TestLinearBasis){
+	const int bits_list[] = { 1, 64, 130 };
+	for(int t = 0; t < 3; ++t){
+		const int bits = bits_list[t], W = (bits + 63) / 64;
+		libcomp::math::BinaryLinearBasis basis(bits);
+		vector< vector<int> > inserted;
+		int rank = 0;
+		for(int q = 0; q < 200; ++q){
+			vector<int> v(bits);
+			vector<ull> packed(W);
+			const int density = testtool::random() % 3 == 0 ? 2 : 50;
+			for(int j = 0; j < bits; ++j){
+				v[j] = static_cast<int>(testtool::random() % 100) < density;
+				if(v[j]){ packed[j >> 6] |= 1ull << (j & 63); }
+			}
+			inserted.push_back(v);
+			const int next_rank = naive_rank(inserted);
+			const bool independent = next_rank > rank;
+			rank = next_rank;
+			EXPECT_EQ(!independent, basis.contains(packed));
+			EXPECT_EQ(independent, basis.insert(packed));
+			EXPECT_TRUE(basis.contains(packed));
+			EXPECT_EQ(rank, basis.size());
+		}
+	}
+}
+
+TEST(MathBinaryMatrix, TestPerformance){
+	const int N = 4096;
+	libcomp::math::BinaryMatrix a(N, N);
+	for(int i = 0; i < N; ++i){
+		for(int j = 0; j < N; ++j){ // xorshift の出力は GF(2) 上で線形なので、非線形な変換を挟む
+			a.set(i, j, testtool::random() % 1000 < 500); }
+	}
+	testtool::StopWatch stopwatch;
+	const int r = a.rank();
+	EXPECT_GE(r, N - 20);
+	ASSERT_LE(stopwatch.get(), 3000u);
+}
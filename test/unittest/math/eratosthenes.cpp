@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "math/eratosthenes.h"
+#include "math/ranged_eratosthenes.h"
+#include "../../utility/random.h"
+#include "../../utility/stopwatch.h"
+
+namespace {
+
+vector<ll> collect_primes(ll low, ll high){
+	vector<ll> primes;
+	libcomp::math::segmented_eratosthenes(low, high, [&](ll p){ primes.push_back(p); });
+	return primes;
+}
+
+}
+
+TEST(MathEratosthenes, TestSegmented){
+	EXPECT_TRUE(collect_primes(0, 0).empty());
+	EXPECT_TRUE(collect_primes(0, 2).empty());
+	for(int n = 2; n <= 1000; ++n){
+		const vector<int> expected = libcomp::math::eratosthenes(n);
+		const vector<ll> actual = collect_primes(0, n);
+		EXPECT_EQ(vector<ll>(expected.begin(), expected.end()), actual);
+	}
+	// 複数の区間と、7, 11, 13 の周期を跨ぐ大きさ
+	const int n = 5000000;
+	const vector<int> expected = libcomp::math::eratosthenes(n);
+	vector<ll> actual;
+	libcomp::math::segmented_eratosthenes(n, [&](ll p){ actual.push_back(p); });
+	EXPECT_EQ(vector<ll>(expected.begin(), expected.end()), actual);
+}
+
+TEST(MathEratosthenes, TestSegmentedRange){
+	for(int t = 0; t < 200; ++t){
+		const ll low = (t < 100 ? testtool::random() % 2000 : testtool::random() % 1000000000ll);
+		const ll high = low + testtool::random() % (t % 10 == 0 ? 1500000 : 3000);
+		EXPECT_EQ(libcomp::math::ranged_eratosthenes(low, high), collect_primes(low, high));
+	}
+	EXPECT_TRUE(collect_primes(100, 100).empty());
+	EXPECT_TRUE(collect_primes(100, 50).empty());
+}
+
+TEST(MathEratosthenes, TestPerformance){
+	const ll N = 200000000;
+	ll count = 0, sum = 0;
+	testtool::StopWatch stopwatch;
+	libcomp::math::segmented_eratosthenes(N, [&](ll p){ ++count; sum += p; });
+	ASSERT_LE(stopwatch.get(), 3000u);
+	EXPECT_EQ(11078937, count);
+	EXPECT_EQ(1075207199997334ll, sum);
+}
@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <complex>
+#include <cstdio>
+#include "math/fft.h"
+#include "misc/thread_pool.h"
+#include "../../utility/random.h"
+#include "../../utility/stopwatch.h"
+
+namespace {
+
+vector< complex<double> > naive_dft(const vector< complex<double> > &a, bool inverse){
+	const int n = a.size();
+	vector< complex<double> > b(n);
+	for(int k = 0; k < n; ++k){
+		for(int j = 0; j < n; ++j){
+			const double theta = (inverse ? -2.0 : 2.0) * M_PI * (static_cast<ll>(j) * k % n) / n;
+			b[k] += a[j] * polar(1.0, theta);
+		}
+		if(inverse){ b[k] /= n; }
+	}
+	return b;
+}
+
+vector<ll> random_sequence(int n, ll range){
+	vector<ll> a(n);
+	for(int i = 0; i < n; ++i){
+		a[i] = static_cast<ll>(testtool::random() % (2 * range + 1)) - range;
+	}
+	return a;
+}
+
+}
+
+TEST(MathFFT, TestTransform){
+	for(int n = 1; n <= 512; n *= 2){
+		const libcomp::math::FFTPlan plan(n);
+		vector< complex<double> > a(n);
+		for(int i = 0; i < n; ++i){
+			a[i] = complex<double>(testtool::random() % 1000, testtool::random() % 1000);
+		}
+		for(int inverse = 0; inverse < 2; ++inverse){
+			const vector< complex<double> > expected = naive_dft(a, inverse);
+			vector< complex<double> > b(a), c(n);
+			plan.transform(b.data(), inverse);
+			libcomp::math::fft(c.data(), a.data(), n, inverse);
+			for(int i = 0; i < n; ++i){
+				EXPECT_NEAR(expected[i].real(), b[i].real(), 1e-6);
+				EXPECT_NEAR(expected[i].imag(), b[i].imag(), 1e-6);
+				EXPECT_NEAR(expected[i].real(), c[i].real(), 1e-6);
+				EXPECT_NEAR(expected[i].imag(), c[i].imag(), 1e-6);
+			}
+		}
+	}
+}
+
+TEST(MathFFT, TestRealTransform){
+	for(int n = 2; n <= 512; n *= 2){
+		const libcomp::math::FFTPlan plan(n);
+		vector<double> a(n);
+		vector< complex<double> > c(n);
+		for(int i = 0; i < n; ++i){ c[i] = a[i] = testtool::random() % 1000; }
+		const vector< complex<double> > expected = naive_dft(c, false);
+		vector< complex<double> > b(n / 2 + 1);
+		plan.real_transform(a.data(), b.data());
+		for(int i = 0; i <= n / 2; ++i){
+			EXPECT_NEAR(expected[i].real(), b[i].real(), 1e-6);
+			EXPECT_NEAR(expected[i].imag(), b[i].imag(), 1e-6);
+		}
+		vector<double> d(n);
+		plan.inverse_real_transform(b.data(), d.data());
+		for(int i = 0; i < n; ++i){ EXPECT_NEAR(a[i], d[i], 1e-6); }
+	}
+}
+
+TEST(MathFFT, TestFourStep){
+	libcomp::misc::ThreadPool pool(4);
+	for(int n = 1; n <= (1 << 15); n *= 2){
+		const libcomp::math::FFTPlan plan(n);
+		const libcomp::math::FourStepFFTPlan four_step(n);
+		vector< complex<double> > a(n);
+		for(int i = 0; i < n; ++i){
+			a[i] = complex<double>(testtool::random() % 1000, testtool::random() % 1000);
+		}
+		for(int inverse = 0; inverse < 2; ++inverse){
+			vector< complex<double> > expected(a), b(n), c(n);
+			plan.transform(expected.data(), inverse);
+			four_step.transform(b.data(), a.data(), inverse);
+			four_step.transform(c.data(), a.data(), inverse, &pool);
+			for(int i = 0; i < n; ++i){
+				EXPECT_NEAR(expected[i].real(), b[i].real(), 1e-6);
+				EXPECT_NEAR(expected[i].imag(), b[i].imag(), 1e-6);
+				EXPECT_NEAR(expected[i].real(), c[i].real(), 1e-6);
+				EXPECT_NEAR(expected[i].imag(), c[i].imag(), 1e-6);
+			}
+		}
+	}
+	const int n = 1 << 20;
+	vector< complex<double> > a(n);
+	for(int i = 0; i < n; ++i){
+		a[i] = complex<double>(testtool::random() % 1000, testtool::random() % 1000);
+	}
+	vector< complex<double> > b(a);
+	libcomp::math::fft(b.data(), b.data(), n, false, &pool);
+	libcomp::math::fft(b.data(), b.data(), n, true);
+	for(int i = 0; i < n; ++i){
+		EXPECT_NEAR(a[i].real(), b[i].real(), 1e-6);
+		EXPECT_NEAR(a[i].imag(), b[i].imag(), 1e-6);
+	}
+}
+
+TEST(MathFFT, TestConvolve){
+	for(int t = 0; t < 200; ++t){
+		const int n = testtool::random() % 600;
+		const int m = testtool::random() % 600;
+		const vector<ll> a = random_sequence(n, 1000), b = random_sequence(m, 1000);
+		const vector<ll> expected = libcomp::math::naive_convolve(a, b);
+		EXPECT_EQ(expected, libcomp::math::karatsuba_convolve(a, b));
+		EXPECT_EQ(expected, libcomp::math::convolve(a, b));
+	}
+	// 丸め誤差が問題になる大きさの値は厳密に計算される
+	// (二乗和と変換長の対数の積は約 2.5e16、各係数の絶対値は 3e15 以下で ll に収まる)
+	const vector<ll> a = random_sequence(3000, 1000000), b = random_sequence(3000, 1000000);
+	EXPECT_EQ(libcomp::math::naive_convolve(a, b), libcomp::math::convolve(a, b));
+	const vector<ll> c = random_sequence(3000, 1000);
+	EXPECT_EQ(libcomp::math::naive_convolve(c, c), libcomp::math::convolve(c, c));
+}
+
+TEST(MathFFT, TestConvolveDouble){
+	vector<double> a(700), b(300);
+	for(size_t i = 0; i < a.size(); ++i){ a[i] = (testtool::random() % 2001) / 1000.0 - 1.0; }
+	for(size_t i = 0; i < b.size(); ++i){ b[i] = (testtool::random() % 2001) / 1000.0 - 1.0; }
+	const vector<double> expected = libcomp::math::naive_convolve(a, b);
+	const vector<double> c = libcomp::math::convolve(a, b);
+	ASSERT_EQ(expected.size(), c.size());
+	for(size_t i = 0; i < c.size(); ++i){ EXPECT_NEAR(expected[i], c[i], 1e-9); }
+}
+
+TEST(MathFFT, TestPerformance){
+	const int N = 1 << 17, Q = 5;
+	const vector<ll> a = random_sequence(N, 1000), b = random_sequence(N, 1000);
+	testtool::StopWatch stopwatch;
+	for(int q = 0; q < Q; ++q){
+		const vector<ll> c = libcomp::math::convolve(a, b);
+		ASSERT_EQ(2 * N - 1, static_cast<int>(c.size()));
+	}
+	ASSERT_LE(stopwatch.get(), 3000u);
+}
+
+// --gtest_also_run_disabled_tests を指定して実行する
+TEST(MathFFT, DISABLED_BenchmarkFourStep){
+	const int threads = max(1u, thread::hardware_concurrency());
+	printf("%10s %8s %12s %12s\n", "n", "threads", "FFTPlan [ms]", "4-step [ms]");
+	for(int log_n = 16; log_n <= 26; log_n += 2){
+		const int n = 1 << log_n;
+		vector< complex<double> > src(n), dst(n);
+		for(int i = 0; i < n; ++i){
+			src[i] = complex<double>(testtool::random() % 1000, testtool::random() % 1000);
+		}
+		const libcomp::math::FFTPlan plan(n);
+		const libcomp::math::FourStepFFTPlan four_step(n);
+		testtool::StopWatch sw_plan;
+		plan.transform(dst.data());
+		const unsigned long long t_plan = sw_plan.get();
+		for(int t = 1; t <= threads; t *= 2){
+			libcomp::misc::ThreadPool pool(t);
+			testtool::StopWatch sw_four_step;
+			four_step.transform(dst.data(), src.data(), false, &pool);
+			printf("%10d %8d %12llu %12llu\n", n, t, t_plan, sw_four_step.get());
+		}
+	}
+}
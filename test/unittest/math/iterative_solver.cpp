@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <cmath>
+#include "math/iterative_solver.h"
+#include "../../utility/random.h"
+#include "../../utility/stopwatch.h"
+
+namespace {
+
+typedef libcomp::math::SparseMatrix<double> Sparse;
+
+double random_real(){
+	return static_cast<double>(testtool::random() % 2000001) / 1000000.0 - 1.0;
+}
+
+// 対角優位な疎行列 (symmetric が真なら対称)
+Sparse random_diagonally_dominant(int n, int d, bool symmetric){
+	vector<Sparse::Entry> entries;
+	vector<double> diagonal(n, 1.0);
+	for(int i = 0; i < n; ++i){
+		for(int k = 0; k < d; ++k){
+			const int j = testtool::random() % n;
+			if(i == j){ continue; }
+			const double v = random_real();
+			entries.push_back(Sparse::Entry(i, j, v));
+			diagonal[i] += fabs(v);
+			if(symmetric){
+				entries.push_back(Sparse::Entry(j, i, v));
+				diagonal[j] += fabs(v);
+			}
+		}
+	}
+	for(int i = 0; i < n; ++i){ entries.push_back(Sparse::Entry(i, i, diagonal[i])); }
+	return Sparse(n, n, entries);
+}
+
+void expect_solution(const Sparse &a, const vector<double> &b, const vector<double> &x){
+	vector<double> ax;
+	a.multiply(x, ax);
+	double residual = 0.0, scale = 0.0;
+	for(size_t i = 0; i < b.size(); ++i){
+		residual += (ax[i] - b[i]) * (ax[i] - b[i]);
+		scale += b[i] * b[i];
+	}
+	EXPECT_LE(sqrt(residual), 1e-8 * sqrt(scale));
+}
+
+}
+
+TEST(MathIterativeSolver, TestConjugateGradient){
+	libcomp::misc::ThreadPool pool(2);
+	const int n = 3000;
+	const Sparse a = random_diagonally_dominant(n, 5, true);
+	libcomp::math::ConjugateGradient cg(n);
+	for(int t = 0; t < 3; ++t){
+		vector<double> b(n), x(n, 0.0);
+		for(int i = 0; i < n; ++i){ b[i] = random_real(); }
+		EXPECT_GT(cg.solve(a, b, x, 1e-10, 10000, t == 1 ? &pool : NULL), 0);
+		expect_solution(a, b, x);
+		// 解から始めた場合は反復しない
+		EXPECT_EQ(0, cg.solve(a, b, x, 1e-6));
+	}
+}
+
+TEST(MathIterativeSolver, TestBiCGSTAB){
+	libcomp::misc::ThreadPool pool(2);
+	const int n = 3000;
+	const Sparse a = random_diagonally_dominant(n, 5, false);
+	libcomp::math::BiCGSTAB solver(n);
+	for(int t = 0; t < 3; ++t){
+		vector<double> b(n), x(n, 0.0);
+		for(int i = 0; i < n; ++i){ b[i] = random_real(); }
+		EXPECT_GT(solver.solve(a, b, x, 1e-10, 10000, t == 1 ? &pool : NULL), 0);
+		expect_solution(a, b, x);
+	}
+}
+
+TEST(MathIterativeSolver, TestPowerIteration){
+	libcomp::misc::ThreadPool pool(2);
+	// ランダムなマルコフ連鎖の定常分布
+	const int n = 2000, d = 5;
+	vector<Sparse::Entry> entries;
+	for(int i = 0; i < n; ++i){
+		entries.push_back(Sparse::Entry(i, (i + 1) % n, 0.5));
+		for(int k = 0; k < d; ++k){
+			entries.push_back(Sparse::Entry(i, testtool::random() % n, 0.5 / d));
+		}
+	}
+	const Sparse p(n, n, entries);
+	libcomp::math::PowerIteration power(n);
+	for(int t = 0; t < 2; ++t){
+		vector<double> x(n, 0.0);
+		EXPECT_GT(power.solve(p, x, 1e-12, 100000, t == 1 ? &pool : NULL, true), 0);
+		EXPECT_NEAR(1.0, power.eigenvalue(), 1e-9);
+		double sum = 0.0;
+		for(int i = 0; i < n; ++i){ sum += x[i]; }
+		for(int i = 0; i < n; ++i){ x[i] /= sum; }
+		vector<double> y;
+		p.multiply_transposed(x, y);
+		for(int i = 0; i < n; ++i){
+			EXPECT_GE(x[i], 0.0);
+			EXPECT_NEAR(x[i], y[i], 1e-10);
+		}
+	}
+	// 絶対値最大の固有値が負の場合
+	const int m = 50;
+	vector<Sparse::Entry> diagonal;
+	diagonal.push_back(Sparse::Entry(0, 0, -3.0));
+	for(int i = 1; i < m; ++i){ diagonal.push_back(Sparse::Entry(i, i, 1.0 - i * 0.01)); }
+	const Sparse q(m, m, diagonal);
+	libcomp::math::PowerIteration negative(m);
+	vector<double> x(m, 0.0);
+	EXPECT_GT(negative.solve(q, x, 1e-12), 0);
+	EXPECT_NEAR(-3.0, negative.eigenvalue(), 1e-9);
+	EXPECT_NEAR(1.0, fabs(x[0]), 1e-9);
+}
+
+TEST(MathIterativeSolver, TestPerformance){
+	const int n = 100000;
+	const Sparse a = random_diagonally_dominant(n, 5, true);
+	libcomp::math::ConjugateGradient cg(n);
+	vector<double> b(n), x(n, 0.0);
+	for(int i = 0; i < n; ++i){ b[i] = random_real(); }
+	testtool::StopWatch stopwatch;
+	EXPECT_GT(cg.solve(a, b, x), 0);
+	ASSERT_LE(stopwatch.get(), 3000u);
+}
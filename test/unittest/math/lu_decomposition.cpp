@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <cmath>
+#include "math/lu_decomposition.h"
+#include "math/sweep_out.h"
+#include "../../utility/random.h"
+#include "../../utility/stopwatch.h"
+
+namespace {
+
+double random_real(){
+	return static_cast<double>(testtool::random() % 2000001) / 1000000.0 - 1.0;
+}
+
+libcomp::math::Matrix<double> random_real_matrix(int n, int m){
+	libcomp::math::Matrix<double> a(n, m);
+	for(int i = 0; i < n; ++i){
+		for(int j = 0; j < m; ++j){ a(i, j) = random_real(); }
+	}
+	return a;
+}
+
+}
+
+TEST(MathLUDecomposition, TestSolve){
+	for(int t = 0; t < 30; ++t){
+		const int n = testtool::random() % 200 + 1;
+		const libcomp::math::Matrix<double> a = random_real_matrix(n, n);
+		vector<double> expected(n), b(n, 0.0);
+		for(int i = 0; i < n; ++i){ expected[i] = random_real(); }
+		for(int i = 0; i < n; ++i){
+			for(int j = 0; j < n; ++j){ b[i] += a(i, j) * expected[j]; }
+		}
+		const libcomp::math::LUDecomposition lu(a);
+		ASSERT_FALSE(lu.is_singular());
+		const vector<double> x = lu.solve(b);
+		ASSERT_EQ(n, static_cast<int>(x.size()));
+		for(int i = 0; i < n; ++i){ EXPECT_NEAR(expected[i], x[i], 1e-6); }
+	}
+}
+
+TEST(MathLUDecomposition, TestSolveMany){
+	for(int t = 0; t < 10; ++t){
+		const int n = testtool::random() % 150 + 1;
+		const int m = testtool::random() % 300 + 1;
+		const libcomp::math::Matrix<double> a = random_real_matrix(n, n);
+		const libcomp::math::Matrix<double> expected = random_real_matrix(n, m);
+		const libcomp::math::Matrix<double> b = a * expected;
+		const libcomp::math::LUDecomposition lu(a);
+		const libcomp::math::Matrix<double> x = lu.solve_many(b);
+		ASSERT_EQ(n, x.rows());
+		ASSERT_EQ(m, x.columns());
+		for(int i = 0; i < n; ++i){
+			for(int j = 0; j < m; ++j){ EXPECT_NEAR(expected(i, j), x(i, j), 1e-6); }
+		}
+	}
+}
+
+TEST(MathLUDecomposition, TestDeterminant){
+	libcomp::math::Matrix<double> a(3, 3);
+	a(0, 0) = 0; a(0, 1) = 2; a(0, 2) = 1;
+	a(1, 0) = 1; a(1, 1) = 0; a(1, 2) = 3;
+	a(2, 0) = 4; a(2, 1) = 1; a(2, 2) = 0;
+	EXPECT_NEAR(25.0, libcomp::math::LUDecomposition(a).determinant(), 1e-9);
+	a(2, 0) = 1; a(2, 1) = 2; a(2, 2) = 4;
+	const libcomp::math::LUDecomposition singular(a);
+	EXPECT_TRUE(singular.is_singular());
+	EXPECT_EQ(0.0, singular.determinant());
+	EXPECT_TRUE(singular.solve(vector<double>(3, 1.0)).empty());
+	EXPECT_EQ(0, singular.solve_many(random_real_matrix(3, 2)).rows());
+	const libcomp::math::Matrix<double> empty =
+		libcomp::math::LUDecomposition(random_real_matrix(3, 3)).solve_many(
+			libcomp::math::Matrix<double>(3, 0));
+	EXPECT_EQ(3, empty.rows());
+	EXPECT_EQ(0, empty.columns());
+}
+
+TEST(MathLUDecomposition, TestSweepOut){
+	vector< vector<double> > a(2, vector<double>(2));
+	a[0][0] = 1; a[0][1] = 2;
+	a[1][0] = 3; a[1][1] = 4;
+	vector<double> b(2);
+	b[0] = 5; b[1] = 6;
+	const vector<double> x = libcomp::math::sweep_out(a, b);
+	ASSERT_EQ(2u, x.size());
+	EXPECT_NEAR(-4.0, x[0], 1e-9);
+	EXPECT_NEAR(4.5, x[1], 1e-9);
+}
+
+TEST(MathLUDecomposition, TestPerformance){
+	const int N = 600;
+	const libcomp::math::Matrix<double> a = random_real_matrix(N, N);
+	const libcomp::math::Matrix<double> b = random_real_matrix(N, N);
+	testtool::StopWatch stopwatch;
+	const libcomp::math::LUDecomposition lu(a);
+	const libcomp::math::Matrix<double> x = lu.solve_many(b);
+	ASSERT_LE(stopwatch.get(), 3000u);
+}
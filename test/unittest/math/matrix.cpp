@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+#include "math/matrix.h"
+#include "../../utility/random.h"
+#include "../../utility/stopwatch.h"
+
+namespace {
+
+template <typename T>
+libcomp::math::Matrix<T> random_matrix(int n, int m){
+	libcomp::math::Matrix<T> a(n, m);
+	for(int i = 0; i < n; ++i){
+		for(int j = 0; j < m; ++j){
+			a(i, j) = static_cast<int>(testtool::random() % 2001) - 1000;
+		}
+	}
+	return a;
+}
+
+}
+
+TEST(MathMatrix, TestMultiplyCorrectness){
+	for(int t = 0; t < 20; ++t){
+		const int n = testtool::random() % 300 + 1;
+		const int m = testtool::random() % 300 + 1;
+		const int l = testtool::random() % 300 + 1;
+		const libcomp::math::Matrix<ll> a = random_matrix<ll>(n, m);
+		const libcomp::math::Matrix<ll> b = random_matrix<ll>(m, l);
+		const libcomp::math::Matrix<ll> c = a * b;
+		ASSERT_EQ(n, c.rows());
+		ASSERT_EQ(l, c.columns());
+		for(int i = 0; i < n; ++i){
+			for(int j = 0; j < l; ++j){
+				ll naive_answer = 0;
+				for(int k = 0; k < m; ++k){ naive_answer += a(i, k) * b(k, j); }
+				EXPECT_EQ(naive_answer, c(i, j));
+			}
+		}
+	}
+}
+
+TEST(MathMatrix, TestSwap){
+	libcomp::math::Matrix<int> a(3, 2);
+	for(int i = 0; i < 3; ++i){
+		for(int j = 0; j < 2; ++j){ a(i, j) = i * 2 + j; }
+	}
+	a.swap_rows(0, 2);
+	EXPECT_EQ(4, a(0, 0)); EXPECT_EQ(5, a(0, 1));
+	EXPECT_EQ(0, a(2, 0)); EXPECT_EQ(1, a(2, 1));
+	a.swap_columns(0, 1);
+	EXPECT_EQ(5, a(0, 0)); EXPECT_EQ(4, a(0, 1));
+	EXPECT_EQ(3, a(1, 0)); EXPECT_EQ(2, a(1, 1));
+}
+
+TEST(MathMatrix, TestMultiplyPerformance){
+	const int N = 512;
+	const libcomp::math::Matrix<double> a = random_matrix<double>(N, N);
+	const libcomp::math::Matrix<double> b = random_matrix<double>(N, N);
+	testtool::StopWatch stopwatch;
+	const libcomp::math::Matrix<double> c = a * b;
+	ASSERT_LE(stopwatch.get(), 3000u);
+}
+
+TEST(MathMatrix, TestParallelMultiply){
+	libcomp::misc::ThreadPool pool(4);
+	const libcomp::math::Matrix<ll> a = random_matrix<ll>(123, 77);
+	const libcomp::math::Matrix<ll> b = random_matrix<ll>(77, 95);
+	const libcomp::math::Matrix<ll> expected = a * b;
+	libcomp::math::Matrix<ll> c(1, 1);
+	libcomp::math::Matrix<ll>::multiply(a, b, c, &pool);
+	ASSERT_EQ(expected.rows(), c.rows());
+	ASSERT_EQ(expected.columns(), c.columns());
+	for(int i = 0; i < c.rows(); ++i){
+		for(int j = 0; j < c.columns(); ++j){ EXPECT_EQ(expected(i, j), c(i, j)); }
+	}
+}
+
+TEST(MathMatrix, TestPow){
+	libcomp::misc::ThreadPool pool(3);
+	const int N = 20;
+	libcomp::math::Matrix<ll> a(N, N);
+	for(int i = 0; i < N; ++i){
+		for(int j = 0; j < N; ++j){ a(i, j) = testtool::random() % 3; }
+	}
+	libcomp::math::Matrix<ll> naive = libcomp::math::Matrix<ll>::identity(N);
+	for(int e = 0; e <= 10; ++e){
+		const libcomp::math::Matrix<ll> x = pow(a, e);
+		const libcomp::math::Matrix<ll> y = pow(a, e, &pool);
+		for(int i = 0; i < N; ++i){
+			for(int j = 0; j < N; ++j){
+				EXPECT_EQ(naive(i, j), x(i, j));
+				EXPECT_EQ(naive(i, j), y(i, j));
+			}
+		}
+		naive = naive * a;
+	}
+}
+
+TEST(MathMatrix, TestExpression){
+	const int N = 37, M = 53;
+	const libcomp::math::Matrix<ll> b = random_matrix<ll>(N, M);
+	const libcomp::math::Matrix<ll> c = random_matrix<ll>(N, M);
+	const libcomp::math::Matrix<ll> d = random_matrix<ll>(N, M);
+	libcomp::math::Matrix<ll> a(1, 1);
+	a = b * 2 + c - d;
+	ASSERT_EQ(N, a.rows());
+	ASSERT_EQ(M, a.columns());
+	for(int i = 0; i < N; ++i){
+		for(int j = 0; j < M; ++j){ EXPECT_EQ(b(i, j) * 2 + c(i, j) - d(i, j), a(i, j)); }
+	}
+	const libcomp::math::Matrix<ll> e = -(b - 3) % 7 + (c + d) / 2;
+	for(int i = 0; i < N; ++i){
+		for(int j = 0; j < M; ++j){
+			EXPECT_EQ(-(b(i, j) - 3) % 7 + (c(i, j) + d(i, j)) / 2, e(i, j));
+			EXPECT_EQ(-(b(i, j) - 3) % 7 + (c(i, j) + d(i, j)) / 2, (-(b - 3) % 7 + (c + d) / 2)(i, j));
+		}
+	}
+	// 右辺に左辺自身が含まれる場合
+	libcomp::math::Matrix<ll> f = b;
+	f = f * 3 - f + c;
+	for(int i = 0; i < N; ++i){
+		for(int j = 0; j < M; ++j){ EXPECT_EQ(b(i, j) * 2 + c(i, j), f(i, j)); }
+	}
+	// 式同士の積
+	const libcomp::math::Matrix<ll> g = (b + c) * random_matrix<ll>(M, 11);
+	EXPECT_EQ(N, g.rows());
+	EXPECT_EQ(11, g.columns());
+}
+
+TEST(MathMatrix, TestCompoundAssignment){
+	const int N = 29, M = 31;
+	const libcomp::math::Matrix<ll> b = random_matrix<ll>(N, M);
+	const libcomp::math::Matrix<ll> c = random_matrix<ll>(N, M);
+	libcomp::math::Matrix<ll> a = b;
+	a += 5; a -= 2; a *= 3; a /= 2; a %= 100;
+	a += c; a -= c * 2; a += a;
+	for(int i = 0; i < N; ++i){
+		for(int j = 0; j < M; ++j){
+			const ll x = ((b(i, j) + 5 - 2) * 3 / 2 % 100 + c(i, j) - c(i, j) * 2) * 2;
+			EXPECT_EQ(x, a(i, j));
+		}
+	}
+	const libcomp::math::Matrix<ll> sq = random_matrix<ll>(N, N);
+	libcomp::math::Matrix<ll> p = sq;
+	p *= sq;
+	const libcomp::math::Matrix<ll> q = sq * sq;
+	for(int i = 0; i < N; ++i){
+		for(int j = 0; j < N; ++j){ EXPECT_EQ(q(i, j), p(i, j)); }
+	}
+}
+
+TEST(MathMatrix, TestExpressionPerformance){
+	const int N = 1024;
+	const libcomp::math::Matrix<ll> b = random_matrix<ll>(N, N);
+	const libcomp::math::Matrix<ll> c = random_matrix<ll>(N, N);
+	const libcomp::math::Matrix<ll> d = random_matrix<ll>(N, N);
+	libcomp::math::Matrix<ll> a(N, N);
+	testtool::StopWatch stopwatch;
+	for(int t = 0; t < 10; ++t){
+		a = b * 2 + c - d;
+		a += b;
+	}
+	ASSERT_LE(stopwatch.get(), 3000u);
+}
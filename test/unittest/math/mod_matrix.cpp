@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "math/mod_matrix.h"
+#include "../../utility/random.h"
+#include "../../utility/stopwatch.h"
+
+namespace {
+
+const ull MOD = 998244353;
+
+libcomp::math::ModMatrix random_mod_matrix(int n, int m, ull mod){
+	libcomp::math::ModMatrix a(n, m, mod);
+	for(int i = 0; i < n; ++i){
+		for(int j = 0; j < m; ++j){ a(i, j) = testtool::random() % mod; }
+	}
+	return a;
+}
+
+ull naive_determinant(const libcomp::math::ModMatrix &a, ull mod){
+	// 置換の総和による定義どおりの計算
+	const int n = a.rows();
+	vector<int> perm(n);
+	for(int i = 0; i < n; ++i){ perm[i] = i; }
+	ull det = 0;
+	do {
+		int inversions = 0;
+		for(int i = 0; i < n; ++i){
+			for(int j = i + 1; j < n; ++j){ if(perm[i] > perm[j]){ ++inversions; } }
+		}
+		ull prod = 1 % mod;
+		for(int i = 0; i < n; ++i){ prod = prod * a(i, perm[i]) % mod; }
+		det = (det + (inversions % 2 ? mod - prod : prod)) % mod;
+	} while(next_permutation(perm.begin(), perm.end()));
+	return det;
+}
+
+}
+
+TEST(MathModMatrix, TestBarrettReduction){
+	const ull mods[] = { 2, 3, 65521, 998244353, 1000000007, 4294967291ull };
+	for(int t = 0; t < 6; ++t){
+		const libcomp::math::BarrettReduction br(mods[t]);
+		for(int i = 0; i < 100000; ++i){
+			const ull z =
+				(static_cast<ull>(testtool::random()) << 32) | testtool::random();
+			EXPECT_EQ(z % mods[t], br.reduce(z));
+		}
+		EXPECT_EQ(0u, br.reduce(~0ull - (~0ull % mods[t])));
+	}
+}
+
+TEST(MathModMatrix, TestMultiplyCorrectness){
+	const ull mods[] = { 2, 1000003, 998244353, 4294967291ull };
+	libcomp::misc::ThreadPool pool(3);
+	for(int t = 0; t < 12; ++t){
+		const ull mod = mods[t % 4];
+		const int n = testtool::random() % 150 + 1;
+		const int m = testtool::random() % 300 + 1;
+		const int l = testtool::random() % 150 + 1;
+		const libcomp::math::ModMatrix a = random_mod_matrix(n, m, mod);
+		const libcomp::math::ModMatrix b = random_mod_matrix(m, l, mod);
+		const libcomp::math::ModMatrix c = a * b;
+		libcomp::math::ModMatrix d(1, 1, mod);
+		libcomp::math::ModMatrix::multiply(a, b, d, &pool);
+		ASSERT_EQ(n, c.rows());
+		ASSERT_EQ(l, c.columns());
+		for(int i = 0; i < n; ++i){
+			for(int j = 0; j < l; ++j){
+				ull naive_answer = 0;
+				for(int k = 0; k < m; ++k){
+					naive_answer = (naive_answer + static_cast<ull>(a(i, k)) * b(k, j)) % mod;
+				}
+				EXPECT_EQ(naive_answer, c(i, j));
+				EXPECT_EQ(naive_answer, d(i, j));
+			}
+		}
+	}
+}
+
+TEST(MathModMatrix, TestConversion){
+	libcomp::math::Matrix<ll> a(2, 2);
+	a(0, 0) = -1; a(0, 1) = 7; a(1, 0) = 14; a(1, 1) = -15;
+	const libcomp::math::ModMatrix b(a, 7);
+	EXPECT_EQ(6u, b(0, 0)); EXPECT_EQ(0u, b(0, 1));
+	EXPECT_EQ(0u, b(1, 0)); EXPECT_EQ(6u, b(1, 1));
+}
+
+TEST(MathModMatrix, TestPow){
+	const int N = 30;
+	const libcomp::math::ModMatrix a = random_mod_matrix(N, N, MOD);
+	libcomp::math::ModMatrix naive = libcomp::math::ModMatrix::identity(N, MOD);
+	for(int e = 0; e <= 10; ++e){
+		const libcomp::math::ModMatrix x = a.pow(e);
+		for(int i = 0; i < N; ++i){
+			for(int j = 0; j < N; ++j){ EXPECT_EQ(naive(i, j), x(i, j)); }
+		}
+		naive = naive * a;
+	}
+}
+
+TEST(MathModMatrix, TestDeterminant){
+	const ull mods[] = { 2, 7, 998244353 };
+	for(int t = 0; t < 300; ++t){
+		const ull mod = mods[t % 3];
+		const int n = testtool::random() % 7 + 1;
+		const libcomp::math::ModMatrix a = random_mod_matrix(n, n, mod);
+		EXPECT_EQ(naive_determinant(a, mod), a.determinant());
+	}
+}
+
+TEST(MathModMatrix, TestInverse){
+	for(int t = 0; t < 20; ++t){
+		const int n = testtool::random() % 100 + 1;
+		const libcomp::math::ModMatrix a = random_mod_matrix(n, n, MOD);
+		const libcomp::math::ModMatrix b = a.inverse();
+		if(a.determinant() == 0){
+			EXPECT_EQ(0, b.rows());
+			continue;
+		}
+		ASSERT_EQ(n, b.rows());
+		const libcomp::math::ModMatrix c = a * b;
+		for(int i = 0; i < n; ++i){
+			for(int j = 0; j < n; ++j){ EXPECT_EQ(i == j ? 1u : 0u, c(i, j)); }
+		}
+	}
+	libcomp::math::ModMatrix singular(2, 2, MOD);
+	singular(0, 0) = 1; singular(0, 1) = 2;
+	singular(1, 0) = 2; singular(1, 1) = 4;
+	EXPECT_EQ(0, singular.inverse().rows());
+	EXPECT_EQ(0u, singular.determinant());
+}
+
+TEST(MathModMatrix, TestRank){
+	for(int t = 0; t < 50; ++t){
+		const int n = testtool::random() % 60 + 1;
+		const int m = testtool::random() % 60 + 1;
+		const int r = testtool::random() % min(n, m) + 1;
+		const libcomp::math::ModMatrix a =
+			random_mod_matrix(n, r, MOD) * random_mod_matrix(r, m, MOD);
+		// 大きな素数の下では確率 1 - O(r/p) で階数は r となる
+		EXPECT_EQ(r, a.rank());
+	}
+	EXPECT_EQ(0, libcomp::math::ModMatrix(3, 4, MOD).rank());
+}
+
+TEST(MathModMatrix, TestMultiplyPerformance){
+	const int N = 256;
+	const libcomp::math::ModMatrix a = random_mod_matrix(N, N, MOD);
+	const libcomp::math::ModMatrix b = random_mod_matrix(N, N, MOD);
+	testtool::StopWatch stopwatch;
+	const libcomp::math::ModMatrix c = a * b;
+	ASSERT_LE(stopwatch.get(), 2000u);
+}
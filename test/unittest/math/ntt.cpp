@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "math/ntt.h"
+#include "math/montgomery_reduction.h"
+#include "../../utility/random.h"
+#include "../../utility/stopwatch.h"
+
+namespace {
+
+vector<unsigned int> random_residues(int n, unsigned int mod){
+	vector<unsigned int> a(n);
+	for(int i = 0; i < n; ++i){ a[i] = testtool::random() % mod; }
+	return a;
+}
+
+vector<unsigned int> naive_convolve_mod(
+	const vector<unsigned int> &a, const vector<unsigned int> &b, ull mod)
+{
+	if(a.empty() || b.empty()){ return vector<unsigned int>(); }
+	vector<ull> c(a.size() + b.size() - 1);
+	for(size_t i = 0; i < a.size(); ++i){
+		for(size_t j = 0; j < b.size(); ++j){ c[i + j] = (c[i + j] + static_cast<ull>(a[i]) * b[j]) % mod; }
+	}
+	return vector<unsigned int>(c.begin(), c.end());
+}
+
+}
+
+TEST(MathNTT, TestMontgomeryReduction){
+	const unsigned int mods[] = { 1, 3, 998244353, 1000000007, 2147483647 };
+	for(const unsigned int mod : mods){
+		const libcomp::math::MontgomeryReduction mr(mod);
+		for(int t = 0; t < 1000; ++t){
+			const unsigned int a = testtool::random() % mod, b = testtool::random() % mod;
+			const unsigned int x = mr.transform(a), y = mr.transform(b);
+			EXPECT_EQ(a, mr.restore(x));
+			EXPECT_EQ(static_cast<ull>(a) * b % mod, mr.restore(mr.multiply(x, y)));
+			EXPECT_EQ(static_cast<ull>(a) * b % mod, mr.multiply(x, b));
+		}
+		EXPECT_EQ(1u % mod, mr.restore(mr.pow(mr.transform(2 % mod), mod - 1)));
+	}
+}
+
+TEST(MathNTT, TestTransform){
+	const unsigned int mod = 998244353;
+	libcomp::math::NumberTheoreticTransform ntt(mod, 3);
+	for(int n = 1; n <= 256; n *= 2){
+		const vector<unsigned int> a = random_residues(n, mod);
+		// 1の原始n乗根
+		const unsigned int w = libcomp::math::MontgomeryReduction(mod).restore(
+			libcomp::math::MontgomeryReduction(mod).pow(
+				libcomp::math::MontgomeryReduction(mod).transform(3), (mod - 1) / n));
+		vector<unsigned int> expected(n);
+		for(int k = 0; k < n; ++k){
+			ull sum = 0, x = 1, wk = 1;
+			for(int i = 0; i < k; ++i){ wk = wk * w % mod; }
+			for(int j = 0; j < n; ++j){
+				sum = (sum + a[j] * x) % mod;
+				x = x * wk % mod;
+			}
+			expected[k] = sum;
+		}
+		vector<unsigned int> b(a);
+		ntt.transform(b);
+		EXPECT_EQ(expected, b);
+		ntt.transform(b, true);
+		EXPECT_EQ(a, b);
+	}
+}
+
+TEST(MathNTT, TestConvolve){
+	const unsigned int mod = 998244353;
+	libcomp::math::NumberTheoreticTransform ntt(mod, 3);
+	for(int t = 0; t < 100; ++t){
+		const int n = testtool::random() % 1000, m = testtool::random() % 1000;
+		const vector<unsigned int> a = random_residues(n, mod), b = random_residues(m, mod);
+		EXPECT_EQ(naive_convolve_mod(a, b, mod), ntt.convolve(a, b));
+	}
+	// ブロック単位の処理を跨ぐ大きさ
+	const vector<unsigned int> a = random_residues(20000, mod), b = random_residues(70, mod);
+	EXPECT_EQ(naive_convolve_mod(a, b, mod), ntt.convolve(a, b));
+}
+
+TEST(MathNTT, TestConvolveMod){
+	const unsigned int mods[] = { 2, 1000000007, 1u << 30 };
+	for(const unsigned int mod : mods){
+		for(int t = 0; t < 20; ++t){
+			const int n = testtool::random() % 1000, m = testtool::random() % 1000;
+			const vector<unsigned int> a = random_residues(n, mod), b = random_residues(m, mod);
+			EXPECT_EQ(naive_convolve_mod(a, b, mod), libcomp::math::convolve_mod(a, b, mod));
+		}
+	}
+	// 係数が最大となる場合
+	const unsigned int mod = (1u << 30) - 1;
+	const vector<unsigned int> a(3000, mod - 1);
+	EXPECT_EQ(naive_convolve_mod(a, a, mod), libcomp::math::convolve_mod(a, a, mod));
+}
+
+TEST(MathNTT, TestPerformance){
+	const int N = 1 << 17, Q = 5;
+	libcomp::math::NumberTheoreticTransform ntt;
+	const vector<unsigned int> a = random_residues(N, ntt.modulus());
+	const vector<unsigned int> b = random_residues(N, ntt.modulus());
+	testtool::StopWatch stopwatch;
+	for(int q = 0; q < Q; ++q){
+		const vector<unsigned int> c = ntt.convolve(a, b);
+		ASSERT_EQ(2 * N - 1, static_cast<int>(c.size()));
+	}
+	const vector<unsigned int> c = libcomp::math::convolve_mod(a, b, 1000000007);
+	ASSERT_EQ(2 * N - 1, static_cast<int>(c.size()));
+	ASSERT_LE(stopwatch.get(), 3000u);
+}
@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "math/polynomial.h"
+#include "../../utility/random.h"
+#include "../../utility/stopwatch.h"
+
+namespace {
+
+const ull MOD = 998244353;
+
+ull pow_mod(ull a, ull e){
+	ull r = 1;
+	for(; e > 0; e >>= 1){
+		if(e & 1){ r = r * a % MOD; }
+		a = a * a % MOD;
+	}
+	return r;
+}
+
+vector<unsigned int> random_polynomial(int n){
+	vector<unsigned int> a(n);
+	for(int i = 0; i < n; ++i){ a[i] = testtool::random() % MOD; }
+	return a;
+}
+
+vector<unsigned int> naive_multiply(const vector<unsigned int> &a, const vector<unsigned int> &b){
+	if(a.empty() || b.empty()){ return vector<unsigned int>(); }
+	vector<unsigned int> c(a.size() + b.size() - 1);
+	for(size_t i = 0; i < a.size(); ++i){
+		for(size_t j = 0; j < b.size(); ++j){ c[i + j] = (c[i + j] + static_cast<ull>(a[i]) * b[j]) % MOD; }
+	}
+	return c;
+}
+
+// g' = f' g から g[k] = (1/k) sum_{i=1}^{k} i f[i] g[k-i]
+vector<unsigned int> naive_exp(const vector<unsigned int> &f, int n){
+	vector<unsigned int> g(n);
+	g[0] = 1;
+	for(int k = 1; k < n; ++k){
+		ull sum = 0;
+		for(int i = 1; i <= k && i < static_cast<int>(f.size()); ++i){
+			sum = (sum + static_cast<ull>(i) * f[i] % MOD * g[k - i]) % MOD;
+		}
+		g[k] = sum * pow_mod(k, MOD - 2) % MOD;
+	}
+	return g;
+}
+
+// f' = g' f から k g[k] = k f[k] - sum_{i=1}^{k-1} i g[i] f[k-i]
+vector<unsigned int> naive_log(const vector<unsigned int> &f, int n){
+	vector<unsigned int> g(n);
+	for(int k = 1; k < n; ++k){
+		ull sum = (k < static_cast<int>(f.size()) ? static_cast<ull>(k) * f[k] % MOD : 0);
+		for(int i = 1; i < k; ++i){
+			if(k - i >= static_cast<int>(f.size())){ continue; }
+			sum = (sum + MOD - static_cast<ull>(i) * g[i] % MOD * f[k - i] % MOD) % MOD;
+		}
+		g[k] = sum * pow_mod(k, MOD - 2) % MOD;
+	}
+	return g;
+}
+
+unsigned int horner(const vector<unsigned int> &f, unsigned int x){
+	ull y = 0;
+	for(int i = f.size() - 1; i >= 0; --i){ y = (y * x + f[i]) % MOD; }
+	return y;
+}
+
+}
+
+TEST(MathPolynomial, TestInverse){
+	libcomp::math::PolynomialRing ring;
+	for(int n = 1; n <= 300; n += 7){
+		vector<unsigned int> f = random_polynomial(testtool::random() % 300 + 1);
+		if(f[0] == 0){ f[0] = 1; }
+		const vector<unsigned int> g = ring.inverse(f, n);
+		ASSERT_EQ(n, static_cast<int>(g.size()));
+		vector<unsigned int> h = naive_multiply(f, g);
+		h.resize(n);
+		vector<unsigned int> expected(n, 0);
+		expected[0] = 1;
+		EXPECT_EQ(expected, h);
+	}
+}
+
+TEST(MathPolynomial, TestLogExp){
+	libcomp::math::PolynomialRing ring;
+	for(int n = 1; n <= 300; n += 7){
+		vector<unsigned int> f = random_polynomial(testtool::random() % 300 + 1);
+		f[0] = 0;
+		const vector<unsigned int> e = ring.exp(f, n);
+		EXPECT_EQ(naive_exp(f, n), e);
+		f[0] = 1;
+		EXPECT_EQ(naive_log(f, n), ring.log(f, n));
+	}
+	const vector<unsigned int> f = random_polynomial(5000);
+	vector<unsigned int> g = ring.log(ring.exp(vector<unsigned int>(1, 0), 1), 1);
+	EXPECT_EQ(vector<unsigned int>(1, 0), g);
+	vector<unsigned int> h(f);
+	h[0] = 0;
+	EXPECT_EQ(h, ring.log(ring.exp(h, 5000), 5000));
+}
+
+TEST(MathPolynomial, TestSqrt){
+	libcomp::math::PolynomialRing ring;
+	for(int t = 0; t < 50; ++t){
+		const int n = testtool::random() % 300 + 1;
+		vector<unsigned int> g = random_polynomial(testtool::random() % 300 + 1);
+		const int shift = testtool::random() % 3;
+		g.insert(g.begin(), shift, 0);
+		vector<unsigned int> f = naive_multiply(g, g);
+		const vector<unsigned int> s = ring.sqrt(f, n);
+		ASSERT_EQ(n, static_cast<int>(s.size()));
+		vector<unsigned int> ss = naive_multiply(s, s);
+		ss.resize(n);
+		f.resize(n);
+		EXPECT_EQ(f, ss);
+	}
+	// 平方非剰余と奇数次の最低次項
+	EXPECT_TRUE(ring.sqrt(vector<unsigned int>(1, 3), 5).empty());
+	EXPECT_TRUE(ring.sqrt(vector<unsigned int>{ 0, 1 }, 5).empty());
+	EXPECT_EQ(vector<unsigned int>(4, 0), ring.sqrt(vector<unsigned int>{ 0, 0, 0 }, 4));
+	// x^n で割り切れる場合は最低次の項によらず 0 が解となる
+	EXPECT_EQ(vector<unsigned int>(2, 0), ring.sqrt(vector<unsigned int>{ 0, 0, 0, 1 }, 2));
+	EXPECT_EQ(vector<unsigned int>(2, 0), ring.sqrt(vector<unsigned int>{ 0, 0, 3 }, 2));
+	EXPECT_EQ(vector<unsigned int>(1, 0), ring.sqrt(vector<unsigned int>{ 0, 1 }, 1));
+}
+
+TEST(MathPolynomial, TestDivide){
+	libcomp::math::PolynomialRing ring;
+	for(int t = 0; t < 100; ++t){
+		const vector<unsigned int> a = random_polynomial(testtool::random() % 500 + 1);
+		vector<unsigned int> b = random_polynomial(testtool::random() % 300 + 1);
+		if(b.back() == 0){ b.back() = 1; }
+		const pair< vector<unsigned int>, vector<unsigned int> > qr = ring.divide(a, b);
+		ASSERT_EQ(b.size() - 1, qr.second.size());
+		vector<unsigned int> c = naive_multiply(b, qr.first);
+		const size_t size = max(max(c.size(), a.size()), qr.second.size());
+		c.resize(size, 0);
+		for(size_t i = 0; i < qr.second.size(); ++i){ c[i] = (c[i] + qr.second[i]) % MOD; }
+		vector<unsigned int> expected(a);
+		expected.resize(size, 0);
+		EXPECT_EQ(expected, c);
+	}
+}
+
+TEST(MathPolynomial, TestEvaluateInterpolate){
+	libcomp::math::PolynomialRing ring;
+	for(int t = 0; t < 10; ++t){
+		const int n = testtool::random() % 1000 + 1;
+		const vector<unsigned int> f = random_polynomial(testtool::random() % 1000 + 1);
+		vector<unsigned int> xs(n);
+		for(int i = 0; i < n; ++i){ xs[i] = (static_cast<ull>(i) * 7919 + t) % MOD; }
+		const vector<unsigned int> ys = ring.evaluate(f, xs);
+		for(int i = 0; i < n; ++i){ EXPECT_EQ(horner(f, xs[i]), ys[i]); }
+		const vector<unsigned int> g = ring.interpolate(xs, ys);
+		ASSERT_EQ(n, static_cast<int>(g.size()));
+		const vector<unsigned int> zs = ring.evaluate(g, xs);
+		EXPECT_EQ(ys, zs);
+		if(static_cast<int>(f.size()) <= n){
+			vector<unsigned int> h(f);
+			h.resize(n, 0);
+			EXPECT_EQ(h, g);
+		}
+	}
+}
+
+TEST(MathPolynomial, TestPerformance){
+	const int N = 1 << 16;
+	libcomp::math::PolynomialRing ring;
+	vector<unsigned int> f = random_polynomial(N);
+	f[0] = 0;
+	testtool::StopWatch stopwatch;
+	const vector<unsigned int> e = ring.exp(f, N);
+	const vector<unsigned int> l = ring.log(e, N);
+	EXPECT_EQ(f, l);
+	const vector<unsigned int> xs = random_polynomial(1 << 12);
+	const vector<unsigned int> ys = ring.evaluate(random_polynomial(1 << 12), xs);
+	ASSERT_LE(stopwatch.get(), 3000u);
+}
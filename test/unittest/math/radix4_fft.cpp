@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include <complex>
+#include <cstdio>
+#include "math/radix4_fft.h"
+#include "math/fft.h"
+#include "../../utility/random.h"
+#include "../../utility/stopwatch.h"
+
+namespace {
+
+vector<double> random_values(int n){
+	vector<double> a(n);
+	for(int i = 0; i < n; ++i){ a[i] = (testtool::random() % 2001) / 1000.0 - 1.0; }
+	return a;
+}
+
+}
+
+TEST(MathRadix4FFT, TestTransform){
+	// 4096 を超える大きさではブロック外の段 (radix4_stage) も通る
+	for(int n = 1; n <= (1 << 18); n *= 2){
+		const libcomp::math::Radix4FFTPlan plan(n);
+		const libcomp::math::FFTPlan reference(n);
+		const vector<double> re = random_values(n), im = random_values(n);
+		for(int inverse = 0; inverse < 2; ++inverse){
+			vector< complex<double> > expected(n);
+			for(int i = 0; i < n; ++i){ expected[i] = complex<double>(re[i], im[i]); }
+			reference.transform(expected.data(), inverse);
+			vector<double> r(re), c(im);
+			plan.transform(r.data(), c.data(), inverse);
+			for(int i = 0; i < n; ++i){
+				EXPECT_NEAR(expected[i].real(), r[i], 1e-9);
+				EXPECT_NEAR(expected[i].imag(), c[i], 1e-9);
+			}
+		}
+	}
+}
+
+TEST(MathRadix4FFT, TestRoundTrip){
+	// 4096 を超える大きさではブロック外の段 (radix4_stage) も通る
+	for(int n = 1; n <= (1 << 18); n *= 2){
+		const libcomp::math::Radix4FFTPlan plan(n);
+		const vector<double> re = random_values(n), im = random_values(n);
+		vector<double> r(re), c(im);
+		plan.transform(r.data(), c.data());
+		plan.transform(r.data(), c.data(), true);
+		for(int i = 0; i < n; ++i){
+			EXPECT_NEAR(re[i], r[i], 1e-12);
+			EXPECT_NEAR(im[i], c[i], 1e-12);
+		}
+	}
+}
+
+TEST(MathRadix4FFT, TestConvolve){
+	for(int t = 0; t < 20; ++t){
+		const int n = testtool::random() % 3000 + 1;
+		const int m = testtool::random() % 3000 + 1;
+		int size = 1;
+		while(size < n + m - 1){ size *= 2; }
+		const libcomp::math::Radix4FFTPlan plan(size);
+		const vector<double> a = random_values(n), b = random_values(m);
+		const vector<double> expected = libcomp::math::naive_convolve(a, b);
+		const vector<double> c = plan.convolve(a, b);
+		ASSERT_EQ(expected.size(), c.size());
+		for(size_t i = 0; i < c.size(); ++i){ EXPECT_NEAR(expected[i], c[i], 1e-8); }
+	}
+}
+
+TEST(MathRadix4FFT, TestPerformance){
+	const int N = 1 << 20, Q = 2;
+	const libcomp::math::Radix4FFTPlan plan(N);
+	vector<double> re = random_values(N), im = random_values(N);
+	testtool::StopWatch stopwatch;
+	for(int q = 0; q < Q; ++q){
+		plan.transform(re.data(), im.data());
+		plan.transform(re.data(), im.data(), true);
+	}
+	ASSERT_LE(stopwatch.get(), 3000u);
+}
+
+// --gtest_also_run_disabled_tests を指定して実行する
+TEST(MathRadix4FFT, DISABLED_Benchmark){
+	printf("%10s %12s %12s %12s\n", "n", "fft [ms]", "FFTPlan [ms]", "Radix4 [ms]");
+	for(int log_n = 10; log_n <= 24; ++log_n){
+		const int n = 1 << log_n;
+		const int repeat = max(1, (1 << 24) / n);
+		const libcomp::math::FFTPlan plan(n);
+		const libcomp::math::Radix4FFTPlan radix4(n);
+		vector< complex<double> > src(n), dst(n);
+		vector<double> re = random_values(n), im = random_values(n);
+		for(int i = 0; i < n; ++i){ src[i] = complex<double>(re[i], im[i]); }
+		testtool::StopWatch sw_fft;
+		for(int r = 0; r < repeat; ++r){ libcomp::math::fft(dst.data(), src.data(), n, r & 1); }
+		const double t_fft = static_cast<double>(sw_fft.get()) / repeat;
+		testtool::StopWatch sw_plan;
+		for(int r = 0; r < repeat; ++r){ plan.transform(dst.data(), r & 1); }
+		const double t_plan = static_cast<double>(sw_plan.get()) / repeat;
+		testtool::StopWatch sw_radix4;
+		for(int r = 0; r < repeat; ++r){ radix4.transform(re.data(), im.data(), r & 1); }
+		const double t_radix4 = static_cast<double>(sw_radix4.get()) / repeat;
+		printf("%10d %12.3f %12.3f %12.3f\n", n, t_fft, t_plan, t_radix4);
+	}
+}
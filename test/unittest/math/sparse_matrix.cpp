@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include <vector>
+#include "math/sparse_matrix.h"
+#include "../../utility/random.h"
+#include "../../utility/stopwatch.h"
+
+namespace {
+
+typedef libcomp::math::SparseMatrix<ll> IntegerSparseMatrix;
+
+}
+
+TEST(MathSparseMatrix, TestMultiplyCorrectness){
+	libcomp::misc::ThreadPool pool(3);
+	for(int t = 0; t < 20; ++t){
+		const int n = testtool::random() % 100 + 1;
+		const int m = testtool::random() % 100 + 1;
+		const int nnz = testtool::random() % (n * m * 2 + 1);
+		vector< vector<ll> > dense(n, vector<ll>(m));
+		vector<IntegerSparseMatrix::Entry> entries;
+		for(int k = 0; k < nnz; ++k){
+			const int i = testtool::random() % n, j = testtool::random() % m;
+			const ll v = static_cast<int>(testtool::random() % 201) - 100;
+			entries.push_back(IntegerSparseMatrix::Entry(i, j, v));
+			dense[i][j] += v;
+		}
+		const IntegerSparseMatrix a(n, m, entries);
+		ASSERT_EQ(n, a.rows());
+		ASSERT_EQ(m, a.columns());
+		ASSERT_LE(a.nonzeros(), nnz);
+		for(int i = 0; i < n; ++i){
+			for(int k = a.row_begin(i); k < a.row_end(i); ++k){
+				EXPECT_EQ(dense[i][a.column_index(k)], a.value(k));
+				if(k > a.row_begin(i)){ EXPECT_LT(a.column_index(k - 1), a.column_index(k)); }
+			}
+		}
+		vector<ll> x(m), z(n);
+		for(int j = 0; j < m; ++j){ x[j] = static_cast<int>(testtool::random() % 201) - 100; }
+		for(int i = 0; i < n; ++i){ z[i] = static_cast<int>(testtool::random() % 201) - 100; }
+		vector<ll> y, yp, w, wp;
+		a.multiply(x, y);
+		a.multiply(x, yp, &pool);
+		a.multiply_transposed(z, w);
+		a.multiply_transposed(z, wp, &pool);
+		for(int i = 0; i < n; ++i){
+			ll expected = 0;
+			for(int j = 0; j < m; ++j){ expected += dense[i][j] * x[j]; }
+			EXPECT_EQ(expected, y[i]);
+			EXPECT_EQ(expected, yp[i]);
+		}
+		for(int j = 0; j < m; ++j){
+			ll expected = 0;
+			for(int i = 0; i < n; ++i){ expected += dense[i][j] * z[i]; }
+			EXPECT_EQ(expected, w[j]);
+			EXPECT_EQ(expected, wp[j]);
+		}
+	}
+}
+
+TEST(MathSparseMatrix, TestPerformance){
+	const int N = 200000, D = 10, Q = 20;
+	vector<libcomp::math::SparseMatrix<double>::Entry> entries;
+	for(int i = 0; i < N; ++i){
+		for(int k = 0; k < D; ++k){
+			entries.push_back(libcomp::math::SparseMatrix<double>::Entry(
+				i, testtool::random() % N, 1.0 / D));
+		}
+	}
+	const libcomp::math::SparseMatrix<double> a(N, N, entries);
+	vector<double> x(N, 1.0), y;
+	testtool::StopWatch stopwatch;
+	for(int q = 0; q < Q; ++q){
+		a.multiply(x, y);
+		a.multiply_transposed(y, x);
+	}
+	ASSERT_LE(stopwatch.get(), 3000u);
+}
@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+#include "math/static_matrix.h"
+#include "math/matrix.h"
+#include "../../utility/random.h"
+#include "../../utility/stopwatch.h"
+
+namespace {
+
+template <int N, int M>
+libcomp::math::StaticMatrix<ll, N, M> random_static_matrix(){
+	libcomp::math::StaticMatrix<ll, N, M> a;
+	for(int i = 0; i < N; ++i){
+		for(int j = 0; j < M; ++j){
+			a(i, j) = static_cast<int>(testtool::random() % 2001) - 1000;
+		}
+	}
+	return a;
+}
+
+template <int N, int M, int L>
+void test_multiply(){
+	for(int t = 0; t < 100; ++t){
+		const libcomp::math::StaticMatrix<ll, N, M> a = random_static_matrix<N, M>();
+		const libcomp::math::StaticMatrix<ll, M, L> b = random_static_matrix<M, L>();
+		const libcomp::math::StaticMatrix<ll, N, L> c = a * b;
+		for(int i = 0; i < N; ++i){
+			for(int j = 0; j < L; ++j){
+				ll naive_answer = 0;
+				for(int k = 0; k < M; ++k){ naive_answer += a(i, k) * b(k, j); }
+				EXPECT_EQ(naive_answer, c(i, j));
+			}
+		}
+	}
+}
+
+constexpr ll fibonacci(int n){
+	return libcomp::math::pow(libcomp::math::StaticMatrix<ll, 2, 2>{ 1, 1, 1, 0 }, n)(0, 1);
+}
+
+static_assert(fibonacci(0) == 0, "");
+static_assert(fibonacci(10) == 55, "");
+static_assert(fibonacci(90) == 2880067194370816120ll, "");
+
+}
+
+TEST(MathStaticMatrix, TestMultiplyCorrectness){
+	test_multiply<2, 2, 2>();
+	test_multiply<3, 3, 3>();
+	test_multiply<4, 4, 4>();
+	test_multiply<8, 8, 8>();
+	test_multiply<3, 5, 2>();
+	test_multiply<1, 7, 1>();
+}
+
+TEST(MathStaticMatrix, TestElementwise){
+	const libcomp::math::StaticMatrix<ll, 3, 4> a = random_static_matrix<3, 4>();
+	const libcomp::math::StaticMatrix<ll, 3, 4> b = random_static_matrix<3, 4>();
+	const libcomp::math::StaticMatrix<ll, 3, 4> c = -(a * 3 - b) % 7 + (a + 2) / 3;
+	for(int i = 0; i < 3; ++i){
+		for(int j = 0; j < 4; ++j){
+			EXPECT_EQ(-(a(i, j) * 3 - b(i, j)) % 7 + (a(i, j) + 2) / 3, c(i, j));
+		}
+	}
+}
+
+TEST(MathStaticMatrix, TestPow){
+	const libcomp::math::StaticMatrix<ll, 3, 3> a = {
+		0, 1, 0,
+		0, 0, 1,
+		1, 1, 1
+	};
+	libcomp::math::Matrix<ll> b(3, 3);
+	for(int i = 0; i < 3; ++i){
+		for(int j = 0; j < 3; ++j){ b(i, j) = a(i, j); }
+	}
+	for(int e = 0; e < 60; ++e){
+		const libcomp::math::StaticMatrix<ll, 3, 3> x = pow(a, e);
+		const libcomp::math::Matrix<ll> y = pow(b, e);
+		for(int i = 0; i < 3; ++i){
+			for(int j = 0; j < 3; ++j){ EXPECT_EQ(y(i, j), x(i, j)); }
+		}
+	}
+}
+
+TEST(MathStaticMatrix, TestPowPerformance){
+	const int Q = 300000;
+	const libcomp::math::StaticMatrix<ull, 2, 2> a = { 1, 1, 1, 0 };
+	testtool::StopWatch stopwatch;
+	ull checksum = 0;
+	for(int i = 0; i < Q; ++i){
+		const ull e = (static_cast<ull>(testtool::random()) << 32) | testtool::random();
+		checksum += pow(a, e)(0, 1);
+	}
+	EXPECT_NE(0u, checksum);
+	ASSERT_LE(stopwatch.get(), 3000u);
+}
@@ -0,0 +1,58 @@
+#include <gtest/gtest.h>
+#include "misc/sliding_minimum_query.h"
+#include "../../utility/random.h"
+#include "../../utility/stopwatch.h"
+#include <algorithm>
+#include <vector>
+
+TEST(MiscSlidingMinimumQuery, TestRingBufferCorrectness){
+	const int N = 1000, K = 17;
+	vector<int> a(N);
+	for(int i = 0; i < N; ++i){ a[i] = testtool::random() % 100; }
+	libcomp::misc::SlidingMinimumQuery<int> smq;
+	libcomp::misc::RingBufferSlidingMinimumQuery<int> rsmq(K);
+	int head = 0, tail = 0;
+	for(int i = 0; i < 10000; ++i){
+		if(head < N && (head == tail || (head - tail < K && testtool::random() % 2))){
+			smq.push(a[head]);
+			rsmq.push(a[head]);
+			++head;
+		}else if(head != tail){
+			smq.pop();
+			rsmq.pop();
+			++tail;
+		}
+		if(head == tail){ continue; }
+		EXPECT_EQ(*min_element(a.begin() + tail, a.begin() + head), rsmq.query());
+		EXPECT_EQ(smq.query(), rsmq.query());
+	}
+}
+
+TEST(MiscSlidingMinimumQuery, TestSlidingWindowMinCorrectness){
+	const int N = 100;
+	vector<int> a(N);
+	for(int i = 0; i < N; ++i){
+		a[i] = static_cast<int>(testtool::random() & 0xffff) - 0x8000;
+	}
+	for(int k = 1; k <= N; ++k){
+		vector<int> result(N - k + 1);
+		libcomp::misc::sliding_window_min(a.begin(), a.end(), k, result.begin());
+		for(int i = 0; i + k <= N; ++i){
+			EXPECT_EQ(*min_element(a.begin() + i, a.begin() + i + k), result[i]);
+		}
+		libcomp::misc::sliding_window_min(
+			a.begin(), a.end(), k, result.begin(), greater<int>());
+		for(int i = 0; i + k <= N; ++i){
+			EXPECT_EQ(*max_element(a.begin() + i, a.begin() + i + k), result[i]);
+		}
+	}
+}
+
+TEST(MiscSlidingMinimumQuery, TestSlidingWindowMinPerformance){
+	testtool::StopWatch stopwatch;
+	const int N = 10000000, K = 1000;
+	vector<int> a(N), result(N - K + 1);
+	for(int i = 0; i < N; ++i){ a[i] = testtool::random(); }
+	libcomp::misc::sliding_window_min(a.begin(), a.end(), K, result.begin());
+	ASSERT_LE(stopwatch.get(), 1000u);
+}
@@ -34,3 +34,21 @@ TEST(StructureBinaryIndexedTree, TestPerformance){
 	ASSERT_LE(stopwatch.get(), 500u);
 }
 
+
+TEST(StructureBinaryIndexedTree, TestUpperBound){
+	const int N = 100;
+	vector<int> naive_vector(N);
+	libcomp::structure::BinaryIndexedTree<int> bit(N);
+	for(int i = 0; i < 1000; ++i){
+		int p = testtool::random() % N;
+		int v = testtool::random() % 10;
+		naive_vector[p] += v;
+		bit.add(p, v);
+		int w = testtool::random() % (N * 5);
+		int naive_answer = 0, s = 0;
+		while(naive_answer < N && s + naive_vector[naive_answer] <= w){
+			s += naive_vector[naive_answer++];
+		}
+		EXPECT_EQ(naive_answer, bit.upper_bound(w));
+	}
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include "structure/hash_map.h"
+#include "../../utility/random.h"
+#include "../../utility/stopwatch.h"
+#include <cstdio>
+#include <map>
+#include <unordered_map>
+
+namespace {
+
+ull random64(){
+	return (static_cast<ull>(testtool::random()) << 32) | testtool::random();
+}
+
+}
+
+TEST(StructureHashMap, TestCorrectness){
+	libcomp::structure::HashMap<ll, int> hash_map;
+	map<ll, int> naive;
+	for(int i = 0; i < 100000; ++i){
+		const ll key = testtool::random() % 1000 * 1000000007ll;
+		const int v = testtool::random();
+		switch(testtool::random() % 4){
+		case 0:
+			EXPECT_EQ(naive.insert(make_pair(key, v)).second, hash_map.insert(key, v));
+			break;
+		case 1:
+			EXPECT_EQ(naive.erase(key), hash_map.erase(key));
+			break;
+		case 2:
+			naive[key] += v;
+			hash_map[key] += v;
+			break;
+		default:
+			if(naive.count(key)){
+				ASSERT_TRUE(hash_map.find(key) != NULL);
+				EXPECT_EQ(naive[key], *hash_map.find(key));
+			}else{
+				EXPECT_TRUE(hash_map.find(key) == NULL);
+			}
+		}
+		ASSERT_EQ(naive.size(), hash_map.size());
+	}
+	vector< pair<ll, int> > bulk;
+	for(int i = 0; i < 1000; ++i){ bulk.push_back(make_pair(-i, i)); }
+	hash_map.insert(bulk.begin(), bulk.end());
+	naive.insert(bulk.begin(), bulk.end());
+	EXPECT_EQ(naive.size(), hash_map.size());
+	size_t visited = 0;
+	hash_map.for_each([&](const ll &k, const int &v){
+		EXPECT_EQ(naive[k], v);
+		++visited;
+	});
+	EXPECT_EQ(naive.size(), visited);
+}
+
+TEST(StructureHashMap, TestPerformance){
+	const int N = 1000000;
+	vector<ull> keys(N);
+	for(int i = 0; i < N; ++i){ keys[i] = random64(); }
+	volatile ull answer = 0; // avoiding optimization
+
+	testtool::StopWatch std_stopwatch;
+	{
+		unordered_map<ull, ull> std_map;
+		std_map.reserve(N);
+		for(int i = 0; i < N; ++i){ std_map[keys[i]] = i; }
+		for(int i = 0; i < N; ++i){ answer += std_map.find(keys[N - 1 - i])->second; }
+	}
+	const unsigned long long std_time = std_stopwatch.get();
+
+	testtool::StopWatch stopwatch;
+	{
+		libcomp::structure::HashMap<ull, ull> hash_map(N);
+		for(int i = 0; i < N; ++i){ hash_map[keys[i]] = i; }
+		for(int i = 0; i < N; ++i){ answer += *hash_map.find(keys[N - 1 - i]); }
+	}
+	const unsigned long long time = stopwatch.get();
+
+	RecordProperty("unordered_map_milliseconds", static_cast<int>(std_time));
+	RecordProperty("hash_map_milliseconds", static_cast<int>(time));
+	ASSERT_LE(time, 3000u);
+}
+
+// --gtest_also_run_disabled_tests を指定して実行する
+TEST(StructureHashMap, DISABLED_Benchmark){
+	const int N = 10000000;
+	vector<ull> keys(N);
+	for(int i = 0; i < N; ++i){ keys[i] = random64(); }
+	volatile ull answer = 0; // avoiding optimization
+	printf("%10s %18s %18s\n", "n", "unordered_map [ms]", "HashMap [ms]");
+
+	testtool::StopWatch std_stopwatch;
+	{
+		unordered_map<ull, ull> std_map;
+		std_map.reserve(N);
+		for(int i = 0; i < N; ++i){ std_map[keys[i]] = i; }
+		for(int i = 0; i < N; ++i){ answer += std_map.find(keys[N - 1 - i])->second; }
+	}
+	const unsigned long long std_time = std_stopwatch.get();
+
+	testtool::StopWatch stopwatch;
+	{
+		libcomp::structure::HashMap<ull, ull> hash_map(N);
+		for(int i = 0; i < N; ++i){ hash_map[keys[i]] = i; }
+		for(int i = 0; i < N; ++i){ answer += *hash_map.find(keys[N - 1 - i]); }
+	}
+	const unsigned long long time = stopwatch.get();
+
+	printf("%10d %18llu %18llu\n", N, std_time, time);
+}
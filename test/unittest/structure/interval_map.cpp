@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include "structure/interval_map.h"
+#include "../../utility/random.h"
+#include "../../utility/stopwatch.h"
+#include <vector>
+
+namespace {
+
+struct RunCollector {
+	vector<int> *values;
+	int *last;
+	void operator()(int a, int b, int v) const {
+		EXPECT_EQ(*last, a);
+		for(int i = a; i < b; ++i){ values->push_back(v); }
+		*last = b;
+	}
+};
+
+}
+
+TEST(StructureIntervalMap, TestCorrectness){
+	const int N = 100;
+	vector<int> naive(N, 0);
+	libcomp::structure::IntervalMap<int, int> imap(0, N, 0);
+	for(int i = 0; i < 10000; ++i){
+		int a = testtool::random() % (N + 1);
+		int b = testtool::random() % (N + 1);
+		if(a > b){ swap(a, b); }
+		const int v = testtool::random() % 3;
+		for(int j = a; j < b; ++j){ naive[j] = v; }
+		imap.assign(a, b, v);
+
+		size_t naive_runs = 1;
+		for(int j = 1; j < N; ++j){
+			if(naive[j] != naive[j - 1]){ ++naive_runs; }
+		}
+		EXPECT_EQ(naive_runs, imap.size());
+
+		int c = testtool::random() % (N + 1);
+		int d = testtool::random() % (N + 1);
+		if(c > d){ swap(c, d); }
+		vector<int> values;
+		int last = c;
+		RunCollector collector = { &values, &last };
+		imap.for_each(c, d, collector);
+		EXPECT_EQ(vector<int>(naive.begin() + c, naive.begin() + d), values);
+		if(c < N){ EXPECT_EQ(naive[c], imap.get(c)); }
+	}
+}
+
+TEST(StructureIntervalMap, TestPerformance){
+	testtool::StopWatch stopwatch;
+	const int N = 1000000000;
+	libcomp::structure::IntervalMap<int, int> imap(0, N, 0);
+	volatile int answer = 0; // avoiding optimization
+	for(int i = 0; i < 200000; ++i){
+		int a = testtool::random() % (N + 1);
+		int b = testtool::random() % (N + 1);
+		if(a > b){ swap(a, b); }
+		imap.assign(a, b, testtool::random() % 16);
+		answer += imap.get(testtool::random() % N);
+	}
+	ASSERT_LE(stopwatch.get(), 1000u);
+}
@@ -0,0 +1,73 @@
+#include <gtest/gtest.h>
+#include "structure/leftist_heap.h"
+#include "../../utility/random.h"
+#include "../../utility/stopwatch.h"
+#include <set>
+#include <vector>
+
+TEST(StructureLeftistHeap, TestCorrectness){
+	const int M = 20;
+	libcomp::structure::LeftistHeap<ll> heaps;
+	vector<int> roots(M, -1);
+	vector< multiset<ll> > naive(M);
+	for(int i = 0; i < 10000; ++i){
+		const int a = testtool::random() % M, b = testtool::random() % M;
+		switch(testtool::random() % 4){
+		case 0:
+			{
+				const ll x = static_cast<int>(testtool::random() & 0xffff) - 0x8000;
+				roots[a] = heaps.push(roots[a], x);
+				naive[a].insert(x);
+			}
+			break;
+		case 1:
+			if(a != b){
+				roots[a] = heaps.meld(roots[a], roots[b]);
+				roots[b] = -1;
+				naive[a].insert(naive[b].begin(), naive[b].end());
+				naive[b].clear();
+			}
+			break;
+		case 2:
+			if(!naive[a].empty()){
+				roots[a] = heaps.pop(roots[a]);
+				naive[a].erase(naive[a].begin());
+			}
+			break;
+		default:
+			{
+				const ll d = static_cast<int>(testtool::random() % 100) - 50;
+				heaps.add(roots[a], d);
+				multiset<ll> shifted;
+				for(multiset<ll>::iterator it = naive[a].begin(); it != naive[a].end(); ++it){
+					shifted.insert(*it + d);
+				}
+				naive[a].swap(shifted);
+			}
+		}
+		for(int j = 0; j < M; ++j){
+			ASSERT_EQ(naive[j].empty(), roots[j] < 0);
+			if(!naive[j].empty()){ EXPECT_EQ(*naive[j].begin(), heaps.top(roots[j])); }
+		}
+	}
+}
+
+TEST(StructureLeftistHeap, TestPerformance){
+	testtool::StopWatch stopwatch;
+	const int N = 200000;
+	libcomp::structure::LeftistHeap<ll> heaps(N);
+	vector<int> roots(N);
+	for(int i = 0; i < N; ++i){ roots[i] = heaps.make(testtool::random()); }
+	// merge subtrees bottom-up along a random rooted tree
+	for(int i = N - 1; i > 0; --i){
+		const int parent = testtool::random() % i;
+		heaps.add(roots[i], 1);
+		roots[parent] = heaps.meld(roots[parent], roots[i]);
+	}
+	volatile ll answer = 0; // avoiding optimization
+	for(int i = 0; i < N / 2; ++i){
+		answer += heaps.top(roots[0]);
+		roots[0] = heaps.pop(roots[0]);
+	}
+	ASSERT_LE(stopwatch.get(), 1000u);
+}
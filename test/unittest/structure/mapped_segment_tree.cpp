@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+#include "structure/segment_tree.h"
+#include "structure/segment_tree/min.h"
+#include "structure/segment_tree/max.h"
+#include "structure/mapped_segment_tree.h"
+#include "../../utility/random.h"
+#include <cstdio>
+#include <cstddef>
+#include <unistd.h>
+
+TEST(StructureMappedSegmentTree, TestCorrectness){
+	typedef libcomp::structure::MinSegmentTreeTraits<int> Traits;
+	const int N = 1000;
+	char path[] = "/tmp/libcomp_segment_tree_XXXXXX";
+	const int fd = mkstemp(path);
+	ASSERT_GE(fd, 0);
+	close(fd);
+	vector<int> values(N);
+	for(int i = 0; i < N; ++i){
+		values[i] = static_cast<int>(testtool::random() & 0xffff) - 0x8000;
+	}
+	libcomp::structure::SegmentTree<Traits> st(values.begin(), values.end());
+	ASSERT_TRUE(st.save(path));
+	{
+		libcomp::structure::MappedSegmentTree<Traits> mapped =
+			libcomp::structure::SegmentTree<Traits>::map(path);
+		ASSERT_TRUE(mapped.is_open());
+		for(int i = 0; i < 1000; ++i){
+			int a = testtool::random() % (N + 1);
+			int b = testtool::random() % (N + 1);
+			if(a > b){ swap(a, b); }
+			EXPECT_EQ(st.query(a, b), mapped.query(a, b));
+		}
+		for(int i = 0; i < N; ++i){ EXPECT_EQ(values[i], mapped[i]); }
+	}
+	{
+		typedef libcomp::structure::MaxSegmentTreeTraits<int> OtherTraits;
+		libcomp::structure::MappedSegmentTree<OtherTraits> mapped(path);
+		EXPECT_FALSE(mapped.is_open());
+	}
+	{
+		// 葉の数を書き換えたファイルは拒否する
+		const ull leaves[] = { 0, 1ull << 40, 1ull << 61 };
+		for(const ull l : leaves){
+			libcomp::structure::SegmentTree<Traits> copied(values.begin(), values.end());
+			ASSERT_TRUE(copied.save(path));
+			FILE *fp = fopen(path, "r+b");
+			ASSERT_TRUE(fp != NULL);
+			fseek(fp, offsetof(libcomp::structure::SegmentTreeImageHeader, leaves), SEEK_SET);
+			fwrite(&l, sizeof(l), 1, fp);
+			fclose(fp);
+			libcomp::structure::MappedSegmentTree<Traits> mapped(path);
+			EXPECT_FALSE(mapped.is_open());
+		}
+	}
+	unlink(path);
+	{
+		libcomp::structure::MappedSegmentTree<Traits> mapped(path);
+		EXPECT_FALSE(mapped.is_open());
+	}
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include "structure/multi_field_segment_tree.h"
+#include "structure/segment_tree.h"
+#include "../../utility/random.h"
+#include "../../utility/stopwatch.h"
+#include <algorithm>
+#include <tuple>
+
+namespace {
+
+const ll NEG_INF = -(1ll << 60);
+
+// (sum, max, count of positive values, maximum prefix sum)
+struct FourFieldTraits {
+	typedef tuple<ll, ll, ll, ll> value_type;
+	value_type default_value() const {
+		return value_type(0, NEG_INF, 0, NEG_INF);
+	}
+	value_type operator()(const value_type &a, const value_type &b) const {
+		return value_type(
+			get<0>(a) + get<0>(b),
+			max(get<1>(a), get<1>(b)),
+			get<2>(a) + get<2>(b),
+			max(get<3>(a), get<0>(a) + get<3>(b)));
+	}
+};
+
+FourFieldTraits::value_type make_leaf(ll x){
+	return FourFieldTraits::value_type(x, x, x > 0 ? 1 : 0, x);
+}
+
+}
+
+TEST(StructureMultiFieldSegmentTree, TestCorrectness){
+	const int N = 100;
+	FourFieldTraits traits;
+	vector<FourFieldTraits::value_type> naive_vector(N, make_leaf(0));
+	libcomp::structure::MultiFieldSegmentTree<FourFieldTraits> st(
+		naive_vector.begin(), naive_vector.end());
+	for(int i = 0; i < 1000; ++i){
+		int p = testtool::random() % N;
+		ll v = static_cast<int>(testtool::random() & 0xffff) - 0x8000;
+		naive_vector[p] = make_leaf(v);
+		st.update(p, make_leaf(v));
+		int a = testtool::random() % (N + 1);
+		int b = testtool::random() % (N + 1);
+		if(a > b){ swap(a, b); }
+		FourFieldTraits::value_type naive_answer = traits.default_value();
+		for(int j = a; j < b; ++j){
+			naive_answer = traits(naive_answer, naive_vector[j]);
+		}
+		EXPECT_EQ(naive_answer, st.query(a, b));
+		EXPECT_EQ(get<1>(naive_answer), get<1>(st.query_fields<1>(a, b)));
+		const FourFieldTraits::value_type partial = st.query_fields<0, 3>(a, b);
+		EXPECT_EQ(get<0>(naive_answer), get<0>(partial));
+		EXPECT_EQ(get<3>(naive_answer), get<3>(partial));
+	}
+}
+
+TEST(StructureMultiFieldSegmentTree, TestPerformance){
+	const int N = 1 << 18, Q = 100000;
+	vector<FourFieldTraits::value_type> init(N);
+	for(int i = 0; i < N; ++i){
+		init[i] = make_leaf(static_cast<int>(testtool::random() & 0xffff) - 0x8000);
+	}
+	vector<int> qa(Q), qb(Q);
+	for(int i = 0; i < Q; ++i){
+		qa[i] = testtool::random() % (N + 1);
+		qb[i] = testtool::random() % (N + 1);
+		if(qa[i] > qb[i]){ swap(qa[i], qb[i]); }
+	}
+	volatile ll answer = 0; // avoiding optimization
+
+	libcomp::structure::SegmentTree<FourFieldTraits> aos(init.begin(), init.end());
+	testtool::StopWatch aos_stopwatch;
+	for(int i = 0; i < Q; ++i){ answer += get<1>(aos.query(qa[i], qb[i])); }
+	const unsigned long long aos_time = aos_stopwatch.get();
+
+	libcomp::structure::MultiFieldSegmentTree<FourFieldTraits> soa(
+		init.begin(), init.end());
+	testtool::StopWatch soa_stopwatch;
+	for(int i = 0; i < Q; ++i){
+		answer += get<1>(soa.query_fields<1>(qa[i], qb[i]));
+	}
+	const unsigned long long soa_time = soa_stopwatch.get();
+
+	RecordProperty("aos_milliseconds", static_cast<int>(aos_time));
+	RecordProperty("soa_milliseconds", static_cast<int>(soa_time));
+	ASSERT_LE(aos_time, 2000u);
+	ASSERT_LE(soa_time, 2000u);
+}
@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+#include "structure/order_statistics_multiset.h"
+#include "../../utility/random.h"
+#include "../../utility/stopwatch.h"
+#include <algorithm>
+#include <deque>
+#include <vector>
+
+TEST(StructureOrderStatisticsMultiset, TestCorrectness){
+	libcomp::structure::OrderStatisticsMultiset ms;
+	vector<ll> naive;
+	for(int i = 0; i < 20000; ++i){
+		// the key range drifts upward over time
+		const ll x = (i / 100) * 1000000000000ll + testtool::random() % 500;
+		if(naive.empty() || testtool::random() % 3 != 0){
+			ms.insert(x);
+			naive.insert(upper_bound(naive.begin(), naive.end(), x), x);
+		}else{
+			const ll y = naive[testtool::random() % naive.size()];
+			EXPECT_TRUE(ms.erase(y));
+			naive.erase(lower_bound(naive.begin(), naive.end(), y));
+			EXPECT_FALSE(ms.erase(-1));
+		}
+		ASSERT_EQ(naive.size(), ms.size());
+		if(!naive.empty()){
+			const int k = testtool::random() % naive.size();
+			EXPECT_EQ(naive[k], ms.kth(k));
+		}
+		EXPECT_EQ(lower_bound(naive.begin(), naive.end(), x) - naive.begin(), ms.rank(x));
+		EXPECT_EQ(count(naive.begin(), naive.end(), x), ms.count(x));
+	}
+}
+
+TEST(StructureOrderStatisticsMultiset, TestSlidingPercentile){
+	const int W = 101;
+	libcomp::structure::SlidingPercentile sp(W);
+	deque<ll> window;
+	for(int i = 0; i < 5000; ++i){
+		const ll x = i * 7 + testtool::random() % 1000;
+		sp.push(x);
+		window.push_back(x);
+		if(window.size() > W){ window.pop_front(); }
+		vector<ll> sorted(window.begin(), window.end());
+		sort(sorted.begin(), sorted.end());
+		EXPECT_EQ(sorted[(sorted.size() - 1) / 2], sp.median());
+		EXPECT_EQ(sorted[static_cast<int>(0.99 * (sorted.size() - 1))], sp.percentile(0.99));
+	}
+}
+
+TEST(StructureOrderStatisticsMultiset, TestPerformance){
+	testtool::StopWatch stopwatch;
+	libcomp::structure::SlidingPercentile sp(10000);
+	volatile ll answer = 0; // avoiding optimization
+	for(int i = 0; i < 50000; ++i){
+		sp.push(i * 16 + testtool::random() % 100000);
+		answer += sp.percentile(0.99);
+	}
+	ASSERT_LE(stopwatch.get(), 1000u);
+}
+
+TEST(StructureOrderStatisticsMultiset, TestPerformanceDistinctKeys){
+	// すべての挿入が未知のキーになる場合
+	const int N = 200000;
+	testtool::StopWatch stopwatch;
+	libcomp::structure::OrderStatisticsMultiset ms;
+	volatile ll answer = 0; // avoiding optimization
+	for(int i = 0; i < N; ++i){
+		const ll x = (static_cast<ll>(testtool::random()) << 31) ^ testtool::random();
+		ms.insert(x);
+		answer += ms.rank(x);
+		if(i % 16 == 0){ answer += ms.kth(i / 2); }
+	}
+	ASSERT_LE(stopwatch.get(), 3000u);
+	EXPECT_EQ(static_cast<size_t>(N), ms.size());
+}
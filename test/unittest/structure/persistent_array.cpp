@@ -0,0 +1,24 @@
+#include <gtest/gtest.h>
+#include "structure/persistent_array.h"
+#include "../../utility/random.h"
+#include <vector>
+
+TEST(StructurePersistentArray, TestCorrectness){
+	const int N = 37;
+	vector< vector<int> > naive(1, vector<int>(N));
+	for(int i = 0; i < N; ++i){ naive[0][i] = i * i; }
+	libcomp::structure::PersistentArray<int> array(naive[0].begin(), naive[0].end());
+	vector<int> versions(1, array.initial());
+	for(int i = 0; i < 1000; ++i){
+		const int v = testtool::random() % versions.size();
+		const int p = testtool::random() % N;
+		const int x = testtool::random();
+		versions.push_back(array.set(versions[v], p, x));
+		naive.push_back(naive[v]);
+		naive.back()[p] = x;
+		const int w = testtool::random() % versions.size();
+		for(int j = 0; j < N; ++j){
+			EXPECT_EQ(naive[w][j], array.get(versions[w], j));
+		}
+	}
+}
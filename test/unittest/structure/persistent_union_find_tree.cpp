@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+#include "structure/persistent_union_find_tree.h"
+#include "structure/union_find_tree.h"
+#include "../../utility/random.h"
+#include "../../utility/stopwatch.h"
+#include <vector>
+
+TEST(StructurePersistentUnionFindTree, TestCorrectness){
+	const int N = 50;
+	libcomp::structure::PersistentUnionFindTree uf(N);
+	vector<int> versions(1, uf.initial());
+	vector<libcomp::structure::UnionFindTree> naive(
+		1, libcomp::structure::UnionFindTree(N));
+	for(int i = 0; i < 1000; ++i){
+		const int v = testtool::random() % versions.size();
+		const int x = testtool::random() % N, y = testtool::random() % N;
+		versions.push_back(uf.unite(versions[v], x, y));
+		naive.push_back(naive[v]);
+		naive.back().unite(x, y);
+		const int w = testtool::random() % versions.size();
+		for(int j = 0; j < 20; ++j){
+			const int a = testtool::random() % N, b = testtool::random() % N;
+			EXPECT_EQ(naive[w].same(a, b), uf.same(versions[w], a, b));
+		}
+	}
+}
+
+TEST(StructurePersistentUnionFindTree, TestPerformance){
+	testtool::StopWatch stopwatch;
+	const int N = 100000;
+	libcomp::structure::PersistentUnionFindTree uf(N);
+	vector<int> versions(1, uf.initial());
+	volatile int answer = 0; // avoiding optimization
+	for(int i = 0; i < 100000; ++i){
+		const int v = testtool::random() % versions.size();
+		const int x = testtool::random() % N, y = testtool::random() % N;
+		versions.push_back(uf.unite(versions[v], x, y));
+		answer += uf.same(versions.back(), testtool::random() % N, testtool::random() % N);
+	}
+	ASSERT_LE(stopwatch.get(), 1000u);
+}
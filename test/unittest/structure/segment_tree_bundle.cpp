@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include "structure/segment_tree_bundle.h"
+#include "structure/segment_tree/min.h"
+#include "../../utility/random.h"
+#include "../../utility/stopwatch.h"
+#include <algorithm>
+#include <climits>
+
+TEST(StructureSegmentTreeBundle, TestCorrectness){
+	typedef libcomp::structure::MinSegmentTreeTraits<int> Traits;
+	const int N = 100, K = 8;
+	vector< vector<int> > naive(K, vector<int>(N, INT_MAX));
+	libcomp::structure::SegmentTreeBundle<Traits, K> bundle(N);
+	for(int i = 0; i < 1000; ++i){
+		int lane = testtool::random() % K;
+		int p = testtool::random() % N;
+		int v = static_cast<int>(testtool::random() & 0xffff) - 0x8000;
+		naive[lane][p] = v;
+		bundle.update(lane, p, v);
+		size_t a[K], b[K];
+		int out[K];
+		for(int j = 0; j < K; ++j){
+			a[j] = testtool::random() % (N + 1);
+			b[j] = testtool::random() % (N + 1);
+			if(a[j] > b[j]){ swap(a[j], b[j]); }
+		}
+		bundle.query_each(a, b, out);
+		for(int j = 0; j < K; ++j){
+			int naive_answer = INT_MAX;
+			for(size_t k = a[j]; k < b[j]; ++k){
+				naive_answer = min(naive_answer, naive[j][k]);
+			}
+			EXPECT_EQ(naive_answer, out[j]);
+			EXPECT_EQ(naive_answer, bundle.query(j, a[j], b[j]));
+		}
+		bundle.query_all(a[0], b[0], out);
+		for(int j = 0; j < K; ++j){
+			int naive_answer = INT_MAX;
+			for(size_t k = a[0]; k < b[0]; ++k){
+				naive_answer = min(naive_answer, naive[j][k]);
+			}
+			EXPECT_EQ(naive_answer, out[j]);
+		}
+	}
+}
+
+TEST(StructureSegmentTreeBundle, TestPerformance){
+	typedef libcomp::structure::MinSegmentTreeTraits<int> Traits;
+	testtool::StopWatch stopwatch;
+	const int N = 1000, K = 16;
+	libcomp::structure::SegmentTreeBundle<Traits, K> bundle(N);
+	volatile int answer = 0; // avoiding optimization
+	for(int i = 0; i < 20000; ++i){
+		int p = testtool::random() % N;
+		int v = static_cast<int>(testtool::random() & 0xffff) - 0x8000;
+		bundle.update(i % K, p, v);
+		size_t a[K], b[K];
+		int out[K];
+		for(int j = 0; j < K; ++j){
+			a[j] = testtool::random() % (N + 1);
+			b[j] = testtool::random() % (N + 1);
+			if(a[j] > b[j]){ swap(a[j], b[j]); }
+		}
+		bundle.query_each(a, b, out);
+		answer += out[0];
+		bundle.query_all(a[0], b[0], out);
+		answer += out[K - 1];
+	}
+	ASSERT_LE(stopwatch.get(), 1000u);
+}
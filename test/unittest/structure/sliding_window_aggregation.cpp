@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include "structure/sliding_window_aggregation.h"
+#include "../../utility/random.h"
+#include "../../utility/stopwatch.h"
+#include <deque>
+#include <utility>
+
+namespace {
+
+const ll MOD = 1000000007;
+
+struct AffineTraits {
+	typedef pair<ll, ll> value_type;
+	value_type default_value() const { return make_pair(1ll, 0ll); }
+	value_type operator()(const value_type &f, const value_type &g) const {
+		// g(f(x))
+		return make_pair(
+			f.first * g.first % MOD, (f.second * g.first + g.second) % MOD);
+	}
+};
+
+template <typename SWAG>
+void test_correctness(SWAG &swag){
+	AffineTraits traits;
+	deque<AffineTraits::value_type> naive;
+	for(int i = 0; i < 100000; ++i){
+		const bool grow = (i / 1000) % 2 == 0;
+		if(naive.empty() || testtool::random() % 4 < (grow ? 3u : 1u)){
+			const AffineTraits::value_type x(
+				testtool::random() % MOD, testtool::random() % MOD);
+			naive.push_back(x);
+			swag.push(x);
+		}else{
+			naive.pop_front();
+			swag.pop();
+		}
+		ASSERT_EQ(naive.size(), swag.size());
+		if(i % 97 != 0){ continue; }
+		AffineTraits::value_type naive_answer = traits.default_value();
+		for(size_t j = 0; j < naive.size(); ++j){
+			naive_answer = traits(naive_answer, naive[j]);
+		}
+		EXPECT_EQ(naive_answer, swag.query());
+	}
+}
+
+}
+
+TEST(StructureSlidingWindowAggregation, TestCorrectness){
+	libcomp::structure::SlidingWindowAggregation<AffineTraits> swag;
+	test_correctness(swag);
+}
+
+TEST(StructureSlidingWindowAggregation, TestDeamortizedCorrectness){
+	libcomp::structure::DeamortizedSlidingWindowAggregation<AffineTraits> swag;
+	test_correctness(swag);
+}
+
+TEST(StructureSlidingWindowAggregation, TestPerformance){
+	testtool::StopWatch stopwatch;
+	const int N = 1000000, K = 1000;
+	libcomp::structure::SlidingWindowAggregation<AffineTraits> swag;
+	libcomp::structure::DeamortizedSlidingWindowAggregation<AffineTraits>
+		daba(K + 1);
+	volatile ll answer = 0; // avoiding optimization
+	for(int i = 0; i < N; ++i){
+		const AffineTraits::value_type x(
+			testtool::random() % MOD, testtool::random() % MOD);
+		swag.push(x);
+		daba.push(x);
+		if(i >= K){
+			swag.pop();
+			daba.pop();
+		}
+		answer += swag.query().second + daba.query().second;
+	}
+	ASSERT_LE(stopwatch.get(), 1000u);
+}